@@ -0,0 +1,96 @@
+#include "bench.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ============================================================
+// Allocation Counting
+// ============================================================
+
+static std::atomic<u64> g_allocCount{0};
+
+void* operator new(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    abort();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+u64 benchAllocCount() { return g_allocCount.load(std::memory_order_relaxed); }
+
+// ============================================================
+// Harness
+// ============================================================
+
+u64 benchNowNs() {
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BenchOptions parseBenchArgs(int argc, char* argv[]) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--quick")) opt.quick = true;
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) opt.filter = argv[++i];
+        else if (!strcmp(argv[i], "--json") && i + 1 < argc)   opt.jsonPath = argv[++i];
+    }
+    return opt;
+}
+
+bool benchSelected(const BenchOptions& opt, const char* name) {
+    return !opt.filter || strstr(name, opt.filter);
+}
+
+static void formatRate(char* buf, size_t n, double v, const char* unit) {
+    if (v >= 1e9)      snprintf(buf, n, "%8.2f G%s", v / 1e9, unit);
+    else if (v >= 1e6) snprintf(buf, n, "%8.2f M%s", v / 1e6, unit);
+    else if (v >= 1e3) snprintf(buf, n, "%8.2f K%s", v / 1e3, unit);
+    else               snprintf(buf, n, "%8.2f  %s", v, unit);
+}
+
+void printBenchResult(const BenchResult& r) {
+    char ops[32], bytes[32] = "";
+    formatRate(ops, sizeof(ops), r.opsPerSec, "op/s");
+    if (r.bytesPerSec > 0) formatRate(bytes, sizeof(bytes), r.bytesPerSec, "B/s");
+    printf("%-40s %12.2f ns/op  %s  %s  %8.3f alloc/op\n",
+           r.name.c_str(), r.nsPerOp, ops, bytes[0] ? bytes : "           -", r.allocsPerOp);
+    fflush(stdout);
+}
+
+bool writeBenchJson(const char* path, const char* suite, const std::vector<BenchResult>& results) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\n  \"suite\": \"%s\",\n  \"version\": \"%s\",\n  \"results\": [\n", suite, APP_VERSION);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.1f, "
+                   "\"bytes_per_sec\": %.1f, \"allocs_per_op\": %.4f, \"iterations\": %llu}%s\n",
+                r.name.c_str(), r.nsPerOp, r.opsPerSec, r.bytesPerSec, r.allocsPerOp,
+                (unsigned long long)r.iterations, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0;
+}
+
+std::string benchReadFile(const char* path) {
+    std::string s;
+    FILE* f = fopen(path, "rb");
+    if (!f) return s;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+    fclose(f);
+    return s;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <switch.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Benchmark Harness
+// ============================================================
+//
+// Each benchmark body performs `items` operations per call. The
+// harness calibrates the iteration count to BENCH_MIN_NS per sample,
+// takes BENCH_SAMPLES samples and reports the median. Heap
+// allocations are counted through replaced global operator new.
+
+static constexpr u64 BENCH_MIN_NS  = 50'000'000;  // 50 ms per sample
+static constexpr int BENCH_SAMPLES = 5;
+
+struct BenchResult {
+    std::string name;
+    double nsPerOp;
+    double opsPerSec;
+    double bytesPerSec;     // 0 when the benchmark has no byte throughput
+    double allocsPerOp;
+    u64    iterations;      // body calls in the reported sample
+};
+
+struct BenchOptions {
+    const char* filter   = nullptr;   // substring match on benchmark name
+    const char* jsonPath = nullptr;
+    bool        quick    = false;     // single short sample, for smoke runs
+};
+
+// Parses --filter <s>, --json <file> and --quick.
+BenchOptions parseBenchArgs(int argc, char* argv[]);
+
+u64  benchNowNs();
+u64  benchAllocCount();
+bool benchSelected(const BenchOptions& opt, const char* name);
+
+// Prevents the optimizer from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename F>
+BenchResult runBench(const BenchOptions& opt, const char* name, u64 items, u64 bytesPerOp, F&& body) {
+    u64 iters = 1;
+    u64 minNs = opt.quick ? BENCH_MIN_NS / 10 : BENCH_MIN_NS;
+    int samples = opt.quick ? 1 : BENCH_SAMPLES;
+
+    // Calibrate
+    for (;;) {
+        u64 t0 = benchNowNs();
+        for (u64 i = 0; i < iters; i++) body();
+        u64 dt = benchNowNs() - t0;
+        if (dt >= minNs / 4 || iters >= (1ULL << 40)) {
+            if (dt > 0) iters = iters * minNs / dt + 1;
+            break;
+        }
+        iters *= 8;
+    }
+
+    std::vector<double> ns(samples), allocs(samples);
+    for (int s = 0; s < samples; s++) {
+        u64 a0 = benchAllocCount();
+        u64 t0 = benchNowNs();
+        for (u64 i = 0; i < iters; i++) body();
+        u64 dt = benchNowNs() - t0;
+        ns[s]     = (double)dt / (double)(iters * items);
+        allocs[s] = (double)(benchAllocCount() - a0) / (double)(iters * items);
+    }
+    std::vector<double> sorted = ns;
+    std::sort(sorted.begin(), sorted.end());
+    double med = sorted[samples / 2];
+    int mi = (int)(std::find(ns.begin(), ns.end(), med) - ns.begin());
+
+    BenchResult r;
+    r.name        = name;
+    r.nsPerOp     = med;
+    r.opsPerSec   = med > 0 ? 1e9 / med : 0;
+    r.bytesPerSec = bytesPerOp ? r.opsPerSec * (double)bytesPerOp : 0;
+    r.allocsPerOp = allocs[mi];
+    r.iterations  = iters;
+    return r;
+}
+
+// Table to stdout, optional JSON file for tracking between releases.
+void printBenchResult(const BenchResult& r);
+bool writeBenchJson(const char* path, const char* suite, const std::vector<BenchResult>& results);
+
+std::string benchReadFile(const char* path);
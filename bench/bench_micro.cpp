@@ -0,0 +1,945 @@
+#include "bench.h"
+#include "cluster.h"
+#include "digest.h"
+#include "filter.h"
+#include "heatmap.h"
+#include "labels.h"
+#include "memsource.h"
+#include "namehash.h"
+#include "pkx.h"
+#include "player.h"
+#include "profile.h"
+#include "regions.h"
+#include "route.h"
+#include "search.h"
+#include "reader.h"
+#include "sigscan.h"
+#include "spatial.h"
+#include "species.h"
+#include "spawners.h"
+#include "stash.h"
+#include "synth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <unordered_set>
+
+// ============================================================
+// Micro-benchmarks: decode, parse, transform, lookup
+// ============================================================
+//
+//   bench_micro [--filter <s>] [--json <file>] [--quick]
+
+// The std::string + sscanf parser parseSpawnerFile() replaced, kept as
+// the throughput baseline and to check the new one parses the same.
+struct RefSpawner {
+    u64 hash;
+    float x, y, z;
+    std::string location;
+    std::string name;
+};
+
+static void parseSpawnerFileRef(const std::string& content, std::vector<RefSpawner>& out) {
+    size_t pos = 0;
+    while (pos < content.size()) {
+        size_t le = content.find('\n', pos);
+        if (le == std::string::npos) le = content.size();
+        std::string line(content, pos, le - pos);
+        pos = le + 1;
+        if (line.size() < 20) continue;
+
+        size_t d1 = line.find(" - ");
+        if (d1 == std::string::npos) continue;
+        size_t hs = d1 + 3;
+        size_t d2 = line.find(" - ", hs);
+        if (d2 == std::string::npos) continue;
+
+        std::string hashStr(line, hs, d2 - hs);
+        if (hashStr.size() != 16) continue;
+        char* ep;
+        u64 hash = strtoull(hashStr.c_str(), &ep, 16);
+        if (ep != hashStr.c_str() + 16) continue;
+
+        size_t v = line.find("V3f(");
+        if (v == std::string::npos) continue;
+        size_t cs = v + 4, ce = line.find(')', cs);
+        if (ce == std::string::npos) continue;
+
+        float x, y, z;
+        std::string coords(line, cs, ce - cs);
+        if (sscanf(coords.c_str(), "%f, %f, %f", &x, &y, &z) != 3) continue;
+
+        std::string loc(line, 0, d1);
+        size_t ns = loc.find_first_not_of(" \t\"");
+        size_t ne = loc.find_last_not_of(" \t\"");
+        if (ns != std::string::npos && ne != std::string::npos)
+            loc = loc.substr(ns, ne - ns + 1);
+        else loc = "";
+
+        std::string name(line, d2 + 3, v - d2 - 3);
+        name = name.substr(0, name.find(" @"));
+
+        out.push_back({hash, x, y, z, std::move(loc), std::move(name)});
+    }
+}
+
+static bool sameAsRef(const std::vector<SpawnerEntry>& got, const std::vector<RefSpawner>& ref) {
+    if (got.size() != ref.size()) return false;
+    for (size_t i = 0; i < got.size(); i++) {
+        const auto& a = got[i];
+        const auto& b = ref[i];
+        if (a.hash != b.hash || a.x != b.x || a.y != b.y || a.z != b.z || b.location != a.location)
+            return false;
+    }
+    return true;
+}
+
+static std::vector<BenchResult> g_results;
+static BenchOptions g_opt;
+
+template <typename F>
+static void bench(const char* name, u64 items, u64 bytesPerOp, F&& body) {
+    if (!benchSelected(g_opt, name)) return;
+    BenchResult r = runBench(g_opt, name, items, bytesPerOp, body);
+    printBenchResult(r);
+    g_results.push_back(r);
+}
+
+int main(int argc, char* argv[]) {
+    g_opt = parseBenchArgs(argc, argv);
+    std::mt19937 rng(12345);
+
+    // romfs/profile.txt unless ./profile.txt overrides it
+    const int mapCount = (int)g_profile.maps.size();
+    std::vector<std::string> files(mapCount);
+    size_t totalBytes = 0;
+    for (int m = 0; m < mapCount; m++) {
+        const char* path = g_profile.maps[m].spawners.c_str();
+        files[m] = benchReadFile(path);
+        totalBytes += files[m].size();
+        if (files[m].empty()) {
+            fprintf(stderr, "Missing %s\n", path);
+            return 1;
+        }
+    }
+    NameTemplates names;
+    std::vector<RefSpawner> refs;
+    for (int m = 0; m < mapCount; m++) {
+        std::vector<RefSpawner> ref;
+        parseSpawnerFileRef(files[m], ref);
+        size_t first = g_spawners.size();
+        parseSpawnerFile(files[m], m, &names);
+        if (!sameAsRef({g_spawners.begin() + first, g_spawners.end()}, ref)) {
+            fprintf(stderr, "parseSpawnerFile disagrees with the reference parser on map %d\n", m);
+            return 1;
+        }
+        refs.insert(refs.end(), ref.begin(), ref.end());
+    }
+    names.finish();
+    std::vector<SpawnerEntry> spawners = g_spawners;
+    printf("%zu spawners, %zu bytes of spawner text\n\n", spawners.size(), totalBytes);
+
+    // --- PKX decode ---------------------------------------------------------
+    {
+        u8 enc[PA9_SIZE], work[PA9_SIZE];
+        for (auto& b : enc) b = (u8)rng();
+        bench("decryptPA9", 1, PA9_SIZE, [&] {
+            memcpy(work, enc, PA9_SIZE);
+            decryptPA9(work, PA9_SIZE);
+            doNotOptimize(work[PA9_SPECIES_OFF]);
+        });
+        bench("pa9Checksum", 1, PA9_STORED - PKX_HEADER, [&] {
+            doNotOptimize(pa9ChecksumValid(work));
+        });
+    }
+    {
+        std::vector<u16> raws(4096);
+        for (auto& r : raws) r = (u16)(rng() % 1100);
+        bench("getNational9", raws.size(), 0, [&] {
+            u32 acc = 0;
+            for (u16 r : raws) acc += getNational9(r);
+            doNotOptimize(acc);
+        });
+        bench("speciesName", raws.size(), 0, [&] {
+            uintptr_t acc = 0;
+            for (u16 r : raws) acc += (uintptr_t)speciesName(r);
+            doNotOptimize(acc);
+        });
+    }
+    {
+        std::vector<u8> stash(g_profile.stashSize);
+        synthesizeStashBlock(stash.data(), 10, rng);
+        std::vector<ShinyEntry> out;
+        out.reserve(16);
+        bench("decodeStash/10", 1, g_profile.stashSize, [&] {
+            out.clear();
+            decodeStash(stash.data(), out);
+            doNotOptimize(out.size());
+        });
+    }
+
+    // --- Change detection ---------------------------------------------------
+    {
+        std::vector<u8> stash(g_profile.stashSize);
+        synthesizeStashBlock(stash.data(), 10, rng);
+        bench("digest64/stash", 1, g_profile.stashSize, [&] {
+            doNotOptimize(digest64(stash.data(), stash.size()));
+        });
+        bench("digest64/slot", 1, g_profile.entrySize, [&] {
+            doNotOptimize(digest64(stash.data(), g_profile.entrySize));
+        });
+
+        // Full poll against an in-memory image: pointer walk, read, digest compare
+        char arg0[] = "bench", arg1[] = "--synth", arg2[] = "10";
+        char* args[] = {arg0, arg1, arg2};
+        MemorySource* mem = createMemorySource(3, args);
+        StashReader reader;
+        std::vector<ShinyEntry> entries;
+        if (reader.attach(*mem) && reader.refresh(entries) == RefreshResult::Changed) {
+            bench("StashReader/refresh-unchanged", 1, g_profile.stashSize, [&] {
+                doNotOptimize(reader.refresh(entries));
+            });
+            bench("StashReader/refresh-changed", 1, g_profile.stashSize, [&] {
+                reader.invalidate();
+                doNotOptimize(reader.refresh(entries));
+            });
+
+            // Verified: one extra block read per poll, plus checksums on change
+            SnapshotOptions verified;
+            verified.mode = SnapshotMode::Verified;
+            reader.setSnapshotOptions(verified);
+            bench("StashReader/verified-unchanged", 1, g_profile.stashSize, [&] {
+                doNotOptimize(reader.refresh(entries));
+            });
+            bench("StashReader/verified-changed", 1, g_profile.stashSize, [&] {
+                reader.invalidate();
+                doNotOptimize(reader.refresh(entries));
+            });
+
+            // Cheat VM: the image backend runs the cheat on each register read
+            reader.setSnapshotOptions(SnapshotOptions());
+            reader.refresh(entries);
+            u64 walkIpc = reader.stats().lastIpc;
+            SnapshotOptions vm;
+            vm.cheatVm = true;
+            reader.setSnapshotOptions(vm);
+            reader.attach(*mem);
+            for (int i = 0; i < 3; i++) reader.refresh(entries);
+            if (reader.cheatActive() && benchSelected(g_opt, "StashReader/cheatvm-unchanged")) {
+                printf("IPC per refresh: walk %llu, cheat VM %llu\n\n",
+                       (unsigned long long)walkIpc, (unsigned long long)reader.stats().lastIpc);
+                bench("StashReader/cheatvm-unchanged", 1, g_profile.stashSize, [&] {
+                    doNotOptimize(reader.refresh(entries));
+                });
+            }
+        }
+        reader.detach();
+        delete mem;
+    }
+
+    // --- Base pointer scan --------------------------------------------------
+    {
+        std::vector<u8> text(16 << 20);
+        for (size_t i = 0; i < text.size(); i += 4) {
+            u32 w = rng();
+            memcpy(&text[i], &w, 4);
+        }
+        Signature sig;
+        parseSignature("FD 7B ?? A9 ?? ?? ?? 90 ?? ?? 40 F9", sig);
+        std::vector<size_t> hits;
+        bench("findSignature/16MB", 1, text.size(), [&] {
+            hits.clear();
+            findSignature(text.data(), text.size(), sig, hits);
+            doNotOptimize(hits.size());
+        });
+        std::vector<u64> targets;
+        bench("scanPointerLoads/16MB", 1, text.size(), [&] {
+            targets.clear();
+            scanPointerLoads(text.data(), text.size(), 0, 0x6000000, 0x6200000, targets);
+            doNotOptimize(targets.size());
+        });
+
+        // Whole detection against the synthetic image: map query, chunked
+        // reads of a 4 MB .text, ranking and chain validation
+        char arg0[] = "bench", arg1[] = "--synth", arg2[] = "10", arg3[] = "--unknown-build";
+        char* args[] = {arg0, arg1, arg2, arg3};
+        MemorySource* mem = createMemorySource(4, args);
+        DmntCheatProcessMetadata meta;
+        mem->getMetadata(&meta);
+        ScanOptions opt;
+        ScanResult res;
+        bench("detectBasePointer/synth", 1, 0, [&] {
+            doNotOptimize(detectBasePointer(*mem, meta, opt, res));
+        });
+        delete mem;
+    }
+
+    // --- Spawner parsing ----------------------------------------------------
+    for (int m = 0; m < mapCount; m++) {
+        char name[64];
+        snprintf(name, sizeof(name), "parseSpawnerFile/t%d", m + 1);
+        const std::string& content = files[m];
+        bench(name, 1, content.size(), [&] {
+            g_spawners.clear();
+            parseSpawnerFile(content, m);
+            doNotOptimize(g_spawners.size());
+        });
+    }
+    {
+        // ~114k lines
+        std::string big;
+        big.reserve(files[0].size() * 100);
+        for (int i = 0; i < 100; i++) big += files[0];
+        bench("parseSpawnerFile/t1x100", 1, big.size(), [&] {
+            g_spawners.clear();
+            parseSpawnerFile(big, 0);
+            doNotOptimize(g_spawners.size());
+        });
+        std::vector<RefSpawner> ref;
+        bench("parseSpawnerFile-sscanf/t1x100", 1, big.size(), [&] {
+            ref.clear();
+            parseSpawnerFileRef(big, ref);
+            doNotOptimize(ref.size());
+        });
+    }
+    g_spawners = spawners;
+
+    // --- Lookup -------------------------------------------------------------
+    {
+        std::vector<u64> hits(1024), misses(1024);
+        for (auto& h : hits)   h = spawners[rng() % spawners.size()].hash;
+        for (auto& h : misses) h = ((u64)rng() << 32) | rng();
+        bench("findSpawner/hit", hits.size(), 0, [&] {
+            uintptr_t acc = 0;
+            for (u64 h : hits) acc += (uintptr_t)findSpawner(h);
+            doNotOptimize(acc);
+        });
+        bench("findSpawner/miss", misses.size(), 0, [&] {
+            uintptr_t acc = 0;
+            for (u64 h : misses) acc += (uintptr_t)findSpawner(h);
+            doNotOptimize(acc);
+        });
+    }
+
+    // --- Spatial index ------------------------------------------------------
+    {
+        // Real Lumiose data, then 100k synthetic spawners in Gaussian blobs
+        std::vector<SpawnerEntry> synth;
+        synth.reserve(100000);
+        std::normal_distribution<float> blob(0.0f, 40.0f);
+        while (synth.size() < 100000) {
+            float cx = (float)(rng() % 4000) - 2000, cz = (float)(rng() % 4000) - 2000;
+            for (int i = 0; i < 500; i++)
+                synth.push_back({rng(), cx + blob(rng), 0, cz + blob(rng), 0, ""});
+        }
+
+        const struct { const char* name; const std::vector<SpawnerEntry>* set; } sets[] = {
+            {"lumiose", &spawners}, {"synth100k", &synth},
+        };
+        for (const auto& set : sets) {
+            const std::vector<SpawnerEntry>& pts = *set.set;
+            SpatialGrid grid;
+            grid.build(pts, 0);
+
+            float minX = 1e30f, maxX = -1e30f, minZ = 1e30f, maxZ = -1e30f;
+            for (const auto& sp : pts) {
+                if (sp.mapIdx != 0) continue;
+                minX = std::min(minX, sp.x); maxX = std::max(maxX, sp.x);
+                minZ = std::min(minZ, sp.z); maxZ = std::max(maxZ, sp.z);
+            }
+            std::vector<std::pair<float, float>> queries(1024);
+            for (auto& q : queries) {
+                q.first  = minX + (maxX - minX) * (float)(rng() % 1000) / 1000.0f;
+                q.second = minZ + (maxZ - minZ) * (float)(rng() % 1000) / 1000.0f;
+            }
+
+            auto brute = [&](float x, float z) {
+                float best = 1e30f;
+                int idx = -1;
+                for (int i = 0; i < (int)pts.size(); i++) {
+                    if (pts[i].mapIdx != 0) continue;
+                    float dx = pts[i].x - x, dz = pts[i].z - z;
+                    float d = dx * dx + dz * dz;
+                    if (d < best) { best = d; idx = i; }
+                }
+                return idx;
+            };
+            for (const auto& q : queries) {
+                int a = grid.nearest(q.first, q.second), b = brute(q.first, q.second);
+                auto d2 = [&](int i) { float dx = pts[i].x - q.first, dz = pts[i].z - q.second; return dx * dx + dz * dz; };
+                if (a != b && d2(a) != d2(b)) {
+                    fprintf(stderr, "SpatialGrid::nearest disagrees with brute force (%s)\n", set.name);
+                    return 1;
+                }
+            }
+
+            char name[64];
+            snprintf(name, sizeof(name), "SpatialGrid/build-%s", set.name);
+            bench(name, 1, 0, [&] { grid.build(pts, 0); });
+            snprintf(name, sizeof(name), "SpatialGrid/nearest-%s", set.name);
+            bench(name, queries.size(), 0, [&] {
+                int acc = 0;
+                for (const auto& q : queries) acc += grid.nearest(q.first, q.second);
+                doNotOptimize(acc);
+            });
+            snprintf(name, sizeof(name), "bruteforce/nearest-%s", set.name);
+            bench(name, 64, 0, [&] {
+                int acc = 0;
+                for (int i = 0; i < 64; i++) acc += brute(queries[i].first, queries[i].second);
+                doNotOptimize(acc);
+            });
+            std::vector<int> hits;
+            hits.reserve(4096);
+            snprintf(name, sizeof(name), "SpatialGrid/radius10-%s", set.name);
+            bench(name, queries.size(), 0, [&] {
+                size_t acc = 0;
+                for (const auto& q : queries) {
+                    hits.clear();
+                    grid.radius(q.first, q.second, 10.0f, hits);
+                    acc += hits.size();
+                }
+                doNotOptimize(acc);
+            });
+        }
+    }
+
+    // --- Marker clusters ----------------------------------------------------
+    {
+        // Lumiose, then 100k spawners in Gaussian blobs spread over its image.
+        // Views are the 680 px panel at zoom 1 and a zoom 16 window.
+        const MapTransform& lumiose = g_profile.maps[0].transform;
+        std::vector<SpawnerEntry> synth;
+        synth.reserve(100000);
+        std::normal_distribution<float> blob(0.0f, 15.0f);
+        while (synth.size() < 100000) {
+            float cx = (float)(rng() % 900) - 950, cz = (float)(rng() % 900) - 950;
+            for (int i = 0; i < 500; i++)
+                synth.push_back({rng(), cx + blob(rng), 0, cz + blob(rng), 0, ""});
+        }
+
+        const struct { const char* name; const std::vector<SpawnerEntry>* set; } sets[] = {
+            {"lumiose", &spawners}, {"synth100k", &synth},
+        };
+        const float panel = 626.0f, minCellPx = 24.0f;
+        for (const auto& set : sets) {
+            ClusterPyramid pyr;
+            pyr.build(*set.set, 0, lumiose);
+
+            // Every level must account for every drawable spawner
+            u64 drawable = 0;
+            for (const auto& sp : *set.set) {
+                double tx = lumiose.convertX(sp.x), tz = lumiose.convertZ(sp.z);
+                drawable += sp.mapIdx == 0 && tx >= 0 && tx < lumiose.texW && tz >= 0 && tz < lumiose.texH;
+            }
+            std::vector<Cluster> out;
+            for (int l = 0; l < pyr.levels(); l++) {
+                out.clear();
+                pyr.query(l, 0, 0, (float)lumiose.texW, (float)lumiose.texH, out);
+                u64 sum = 0;
+                for (const Cluster& c : out) sum += c.count;
+                if (sum != drawable) {
+                    fprintf(stderr, "ClusterPyramid level %d loses spawners (%s)\n", l, set.name);
+                    return 1;
+                }
+            }
+
+            char name[64];
+            snprintf(name, sizeof(name), "ClusterPyramid/build-%s", set.name);
+            bench(name, 1, 0, [&] { pyr.build(*set.set, 0, lumiose); });
+            out.reserve(4096);
+            for (int zoom : {1, 16}) {
+                float win = (float)lumiose.texW / zoom;
+                float scale = panel / win;
+                int level = pyr.levelFor(scale, minCellPx);
+                std::vector<std::pair<float, float>> views(64);
+                for (auto& v : views) {
+                    v.first  = (float)(rng() % 1000) / 1000.0f * ((float)lumiose.texW - win);
+                    v.second = (float)(rng() % 1000) / 1000.0f * ((float)lumiose.texH - win);
+                }
+                size_t most = 0;
+                snprintf(name, sizeof(name), "ClusterPyramid/view-x%d-%s", zoom, set.name);
+                bench(name, views.size(), 0, [&] {
+                    for (const auto& v : views) {
+                        out.clear();
+                        pyr.query(level, v.first, v.second, v.first + win, v.second + win, out);
+                        most = std::max(most, out.size());
+                    }
+                    doNotOptimize(most);
+                });
+                // Markers per frame are capped by the panel's cell count
+                size_t cap = (size_t)(panel / minCellPx + 2) * (size_t)(panel / minCellPx + 2) * 4;
+                if (most > cap) {
+                    fprintf(stderr, "ClusterPyramid x%d view drew %zu markers (%s)\n", zoom, most, set.name);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // --- Location labels ----------------------------------------------------
+    {
+        // Font metrics stand in for TTF_SizeUTF8: 8 px per byte, 18 px high
+        const MapTransform& lumiose = g_profile.maps[0].transform;
+        LabelLayer layer;
+        layer.build(spawners, 0, lumiose);
+        for (LabelAnchor& a : layer.anchors()) {
+            a.w = 8 * (int)strlen(a.name);
+            a.h = 18;
+        }
+        const float panel = 626.0f;
+        for (int zoom : {1, 16}) {
+            float scale = panel * zoom / (float)lumiose.texW;
+            char name[64];
+            snprintf(name, sizeof(name), "LabelLayer/layout-x%d", zoom);
+            bench(name, 1, 0, [&] {
+                layer.dropLayouts();
+                doNotOptimize(layer.layout(scale, lumiose.texW, lumiose.texH).size());
+            });
+
+            // Placed labels must never overlap
+            const std::vector<PlacedLabel>& placed = layer.layout(scale, lumiose.texW, lumiose.texH);
+            for (size_t i = 0; i < placed.size(); i++) {
+                const LabelAnchor& a = layer.anchors()[placed[i].anchor];
+                for (size_t j = i + 1; j < placed.size(); j++) {
+                    const LabelAnchor& b = layer.anchors()[placed[j].anchor];
+                    if (placed[i].x < placed[j].x + b.w && placed[j].x < placed[i].x + a.w &&
+                        placed[i].y < placed[j].y + b.h && placed[j].y < placed[i].y + a.h) {
+                        fprintf(stderr, "LabelLayer x%d overlaps %s and %s\n", zoom, a.name, b.name);
+                        return 1;
+                    }
+                }
+            }
+
+            // A frame with the layout cached: lookup plus culling to the view
+            snprintf(name, sizeof(name), "LabelLayer/frame-x%d", zoom);
+            bench(name, 1, 0, [&] {
+                const std::vector<PlacedLabel>& labels = layer.layout(scale, lumiose.texW, lumiose.texH);
+                int ox = (int)(rng() % 4096 * scale / zoom), oy = ox / 2, shown = 0;
+                for (const PlacedLabel& p : labels) {
+                    const LabelAnchor& a = layer.anchors()[p.anchor];
+                    shown += p.x >= ox && p.y >= oy && p.x + a.w <= ox + panel && p.y + a.h <= oy + panel;
+                }
+                doNotOptimize(shown);
+            });
+        }
+    }
+
+    // --- Location regions ---------------------------------------------------
+    {
+        // Real maps, then 100k spawners spread over 64 locations
+        static char synthNames[64][8];
+        std::vector<SpawnerEntry> synth;
+        synth.reserve(100000);
+        for (int i = 0; i < 64; i++) snprintf(synthNames[i], sizeof(synthNames[i]), "loc%d", i);
+        std::normal_distribution<float> blob(0.0f, 25.0f);
+        while (synth.size() < 100000) {
+            int loc = (int)(synth.size() / 500) % 64;
+            float cx = (float)(rng() % 900) - 950, cz = (float)(rng() % 900) - 950;
+            for (int i = 0; i < 500; i++)
+                synth.push_back({rng(), cx + blob(rng), 0, cz + blob(rng), 0, synthNames[loc]});
+        }
+
+        std::vector<Region> out;
+        for (int m = 0; m <= mapCount; m++) {
+            const std::vector<SpawnerEntry>& set = m < mapCount ? spawners : synth;
+            int mapIdx = m < mapCount ? m : 0;
+            const MapTransform& tr = g_profile.maps[mapIdx].transform;
+            buildRegions(set, mapIdx, tr, out);
+
+            // Every spawner must lie inside (or on) its location's hull
+            for (const auto& sp : set) {
+                if (sp.mapIdx != mapIdx) continue;
+                float x = (float)tr.convertX(sp.x), z = (float)tr.convertZ(sp.z);
+                for (const Region& r : out) {
+                    if (r.location != sp.location) continue;
+                    int n = (int)r.hull.size() / 2;
+                    for (int i = 0; i < n; i++) {
+                        int j = (i + 1) % n;
+                        float ex = r.hull[2 * j] - r.hull[2 * i], ez = r.hull[2 * j + 1] - r.hull[2 * i + 1];
+                        float c = ex * (z - r.hull[2 * i + 1]) - ez * (x - r.hull[2 * i]);
+                        if (c < -1e-2f * (std::abs(ex) + std::abs(ez))) {
+                            fprintf(stderr, "buildRegions: spawner outside the %s hull\n", r.location);
+                            return 1;
+                        }
+                    }
+                }
+            }
+
+            char name[64];
+            if (m < mapCount) snprintf(name, sizeof(name), "buildRegions/t%d", m + 1);
+            else              snprintf(name, sizeof(name), "buildRegions/synth100k");
+            bench(name, 1, 0, [&] {
+                buildRegions(set, mapIdx, tr, out);
+                doNotOptimize(out.size());
+            });
+        }
+    }
+
+    // --- Route planner ------------------------------------------------------
+    {
+        // Stash-sized and filtered-list-sized sets of real Lumiose spawners
+        std::vector<const SpawnerEntry*> lumiose;
+        for (const auto& sp : spawners)
+            if (sp.mapIdx == 0) lumiose.push_back(&sp);
+        for (int n : {10, 100, 500}) {
+            std::vector<RoutePoint> pts;
+            for (int i = 0; i < n; i++) {
+                const SpawnerEntry* sp = lumiose[rng() % lumiose.size()];
+                pts.push_back({sp->x, sp->z});
+            }
+            std::vector<int> order;
+            routeSeed(pts, order);
+            float seed = routeLength(pts, order);
+            int passes = 0;
+            while (routeImprove(pts, order)) passes++;
+            float best = routeLength(pts, order);
+            std::vector<int> check = order;
+            std::sort(check.begin(), check.end());
+            for (int i = 0; i < n; i++) {
+                if (check[i] != i || best > seed + 1e-2f) {
+                    fprintf(stderr, "Route planner broke the order (%d points)\n", n);
+                    return 1;
+                }
+            }
+            printf("route %d points: seed %.0f, refined %.0f (-%.1f%%) in %d passes\n",
+                   n, seed, best, 100.0 * (seed - best) / seed, passes);
+
+            char name[64];
+            snprintf(name, sizeof(name), "route/seed-%d", n);
+            bench(name, 1, 0, [&] { routeSeed(pts, order); doNotOptimize(order.data()); });
+            snprintf(name, sizeof(name), "route/full-%d", n);
+            bench(name, 1, 0, [&] {
+                routeSeed(pts, order);
+                while (routeImprove(pts, order)) {}
+                doNotOptimize(order.data());
+            });
+        }
+    }
+
+    // --- Player tracking ----------------------------------------------------
+    {
+        // Per-frame work on the render thread: interpolate the marker, then
+        // distance and bearing to a full stash worth of spawners
+        const MapTransform& tr = g_profile.maps[0].transform;
+        PlayerSample a = {{100, 0, 100}, 1'000'000'000}, b = {{110, 2, 120}, 1'033'333'333};
+        PlayerPos mid = interpolatePlayer(a, b, (a.ns + b.ns) / 2);
+        PlayerSample warp = {{900, 0, 900}, b.ns};
+        if (std::fabs(mid.x - 105) > 1e-3f || std::fabs(mid.z - 110) > 1e-3f ||
+            interpolatePlayer(a, warp, (a.ns + b.ns) / 2).x != 900) {
+            fprintf(stderr, "Player interpolation is off\n");
+            return 1;
+        }
+        std::vector<const SpawnerEntry*> stash;
+        for (const auto& sp : spawners)
+            if (sp.mapIdx == 0 && stash.size() < (size_t)g_profile.slots) stash.push_back(&sp);
+        u64 t = a.ns;
+        bench("player/frame", 1, 0, [&] {
+            t = a.ns + (t + 7'000'000 - a.ns) % (b.ns - a.ns);
+            PlayerPos p = interpolatePlayer(a, b, t);
+            float acc = 0;
+            for (const SpawnerEntry* sp : stash) {
+                float d, deg;
+                playerBearing(tr, p, sp->x, sp->z, &d, &deg);
+                acc += d + deg;
+            }
+            doNotOptimize(acc);
+        });
+    }
+
+    // --- Spawner search -----------------------------------------------------
+    {
+        // Typing a location one key at a time (each key narrows the last
+        // matches) against a fresh search per key, on the real spawners and
+        // a 100x copy with random hashes. Checked against a plain scan.
+        std::vector<SpawnerEntry> big;
+        big.reserve(spawners.size() * 100);
+        for (int k = 0; k < 100; k++)
+            for (const SpawnerEntry& sp : spawners) {
+                big.push_back(sp);
+                big.back().hash = ((u64)rng() << 32) | rng();
+            }
+
+        auto brute = [](const std::vector<SpawnerEntry>& set, const std::string& q) {
+            std::vector<u32> out;
+            u64 prefix = 0;
+            int digits = 0;
+            bool hex = !q.empty() && q.size() <= 16 &&
+                       q.find_first_not_of("0123456789abcdef") == std::string::npos;
+            if (hex) { prefix = strtoull(q.c_str(), nullptr, 16); digits = (int)q.size(); }
+            for (u32 i = 0; i < (u32)set.size(); i++)
+                if (foldSearchText(set[i].location).find(q) != std::string::npos ||
+                    (hex && set[i].hash >> (4 * (16 - digits)) == prefix))
+                    out.push_back(i);
+            return out;
+        };
+
+        struct SearchCase { const char* name; const std::vector<SpawnerEntry>* set; };
+        const std::string typed = "wild zone 1";
+        const char* const checks[] = {"wild zone 1", "zone", "ZONE 9", "464c", "0x464c", "e", "no such place"};
+        for (const SearchCase& sc : {SearchCase{"real", &spawners}, SearchCase{"x100", &big}}) {
+            SpawnerSearch s;
+            s.build(*sc.set);
+            for (const char* q : checks) {
+                std::string fq = foldSearchText(q);
+                if (fq.compare(0, 2, "0x") == 0) fq.erase(0, 2);
+                std::vector<u32> want = brute(*sc.set, fq);
+                for (bool narrow : {false, true}) {
+                    if (narrow) {
+                        s.search("");
+                        for (size_t i = 1; i < strlen(q); i++) s.search(std::string(q, i));
+                    } else {
+                        s.search("");
+                    }
+                    std::vector<u32> got;
+                    for (u32 pos : s.search(q)) got.push_back(s.spawnerAt(pos));
+                    std::sort(got.begin(), got.end());
+                    if (got != want) {
+                        fprintf(stderr, "Spawner search for \"%s\" (%s%s) found %zu, expected %zu\n",
+                                q, sc.name, narrow ? ", typed" : "", got.size(), want.size());
+                        return 1;
+                    }
+                }
+            }
+
+            char name[64];
+            snprintf(name, sizeof(name), "search/build-%s", sc.name);
+            bench(name, sc.set->size(), 0, [&] { s.build(*sc.set); doNotOptimize(s.size()); });
+            snprintf(name, sizeof(name), "search/type-%s", sc.name);
+            bench(name, typed.size(), 0, [&] {
+                s.search("");
+                for (size_t i = 1; i <= typed.size(); i++) doNotOptimize(s.search(typed.substr(0, i)).size());
+            });
+            snprintf(name, sizeof(name), "search/rescan-%s", sc.name);
+            bench(name, typed.size(), 0, [&] {
+                for (size_t i = 1; i <= typed.size(); i++) {
+                    s.search("");
+                    doNotOptimize(s.search(typed.substr(0, i)).size());
+                }
+            });
+            std::vector<BrowserRow> rows;
+            snprintf(name, sizeof(name), "search/rows-%s", sc.name);
+            bench(name, 1, 0, [&] { s.buildRows(s.search(""), rows); doNotOptimize(rows.data()); });
+        }
+    }
+
+    // --- Map filters --------------------------------------------------------
+    {
+        // Compiling and combining a filter into a map's bitset, then walking
+        // the set bits, against testing every spawner of the map; on each
+        // real map and 100k synthetic spawners with real location names.
+        // Every expression is checked against a per-spawner predicate.
+        std::vector<SpawnerEntry> synth;
+        synth.reserve(100000);
+        while (synth.size() < 100000) {
+            const SpawnerEntry& sp = spawners[rng() % spawners.size()];
+            synth.push_back({((u64)rng() << 32) | rng(), (float)(rng() % 140) - 70, 0,
+                             (float)(rng() % 160) - 80, 1, sp.location});
+        }
+        std::vector<u64> stash;
+        for (int i = 0; i < g_profile.slots; i++) stash.push_back(spawners[rng() % spawners.size()].hash);
+        for (int i = 0; i < g_profile.slots; i++) stash.push_back(synth[rng() % synth.size()].hash);
+
+        auto has = [](const char* s, const char* sub) {
+            return foldSearchText(s).find(sub) != std::string::npos;
+        };
+        auto stashed = [&](const SpawnerEntry& sp) {
+            return std::find(stash.begin(), stash.end(), sp.hash) != stash.end();
+        };
+        struct FilterCase {
+            const char* expr;
+            std::function<bool(const SpawnerEntry&)> pred;
+        };
+        const FilterCase exprs[] = {
+            {"stash", stashed},
+            {"loc:wild zone", [&](const SpawnerEntry& sp) { return has(sp.location, "wild zone"); }},
+            {"(loc:wild zone | stash) & !hash:4", [&](const SpawnerEntry& sp) {
+                 return (has(sp.location, "wild zone") || stashed(sp)) && (sp.hash >> 60) != 4;
+             }},
+            {"!map:lumiose | loc:\"Wild Zone 1\"", [&](const SpawnerEntry& sp) {
+                 return !has(g_profile.maps[sp.mapIdx].name.c_str(), "lumiose") ||
+                        foldSearchText(sp.location) == "wild zone 1";
+             }},
+        };
+
+        struct SetCase { std::string name; const std::vector<SpawnerEntry>* set; int map; };
+        std::vector<SetCase> sets;
+        for (int m = 0; m < mapCount; m++) sets.push_back({"map" + std::to_string(m), &spawners, m});
+        sets.push_back({"synth100k", &synth, 1});
+
+        SpawnerFilter filter;
+        SpawnerBits bits;
+        for (const SetCase& sc : sets) {
+            FilterIndex idx;
+            idx.build(*sc.set, sc.map, g_profile.maps[sc.map].transform);
+            for (const FilterCase& fc : exprs) {
+                if (const char* err = filter.parse(fc.expr)) {
+                    fprintf(stderr, "Filter \"%s\" does not parse: %s\n", fc.expr, err);
+                    return 1;
+                }
+                filter.evaluate(idx, sc.map, stash, bits);
+                u32 want = 0;
+                for (u32 b = 0; b < idx.size(); b++) {
+                    bool pass = fc.pred((*sc.set)[idx.spawner(b)]);
+                    want += pass;
+                    if (bits.test(b) != pass) {
+                        fprintf(stderr, "Filter \"%s\" disagrees with the predicate on %s\n", fc.expr, sc.name.c_str());
+                        return 1;
+                    }
+                }
+                if (bits.count() != want) {
+                    fprintf(stderr, "Filter \"%s\" sets bits past the end on %s\n", fc.expr, sc.name.c_str());
+                    return 1;
+                }
+            }
+
+            // The three-term expression: bitset build, set-bit walk, and the
+            // per-point test it replaces
+            const FilterCase& fc = exprs[2];
+            filter.parse(fc.expr);
+            char name[64];
+            snprintf(name, sizeof(name), "filter/eval-%s", sc.name.c_str());
+            bench(name, idx.size(), 0, [&] { filter.evaluate(idx, sc.map, stash, bits); doNotOptimize(bits.size()); });
+            float acc = 0;
+            snprintf(name, sizeof(name), "filter/walk-%s", sc.name.c_str());
+            bench(name, idx.size(), 0, [&] {
+                bits.forEach([&](u32 b) { acc += idx.texX(b); });
+                doNotOptimize(acc);
+            });
+            snprintf(name, sizeof(name), "filter/scan-%s", sc.name.c_str());
+            bench(name, idx.size(), 0, [&] {
+                for (u32 b = 0; b < idx.size(); b++)
+                    if (fc.pred((*sc.set)[idx.spawner(b)])) acc += idx.texX(b);
+                doNotOptimize(acc);
+            });
+        }
+    }
+
+    // --- Spawner names ------------------------------------------------------
+    {
+        // Every known name hashes to its spawner; a search over the name
+        // templates finds known names, one no file has, and agrees with
+        // the one-name-at-a-time baseline. Items are candidate names.
+        std::unordered_set<std::string> known;
+        for (const RefSpawner& r : refs) {
+            if (spawnerNameHash(r.name) != r.hash) {
+                fprintf(stderr, "%s does not hash to %016llX\n", r.name.c_str(), (unsigned long long)r.hash);
+                return 1;
+            }
+            known.insert(r.name);
+        }
+
+        // A known name with its last number changed to one no file uses
+        std::string novel;
+        for (const RefSpawner& r : refs) {
+            size_t end = r.name.find_last_of("0123456789");
+            if (end == std::string::npos) continue;
+            size_t begin = r.name.find_last_not_of("0123456789", end) + 1;
+            int width = (int)(end + 1 - begin);
+            if (width > 3) continue;
+            for (int n = 0, lim = width == 1 ? 10 : width == 2 ? 100 : 1000; n < lim && novel.empty(); n++) {
+                char digits[8];
+                snprintf(digits, sizeof(digits), "%0*d", width, n);
+                std::string cand = r.name.substr(0, begin) + digits + r.name.substr(end + 1);
+                if (!known.count(cand)) novel = cand;
+            }
+            if (!novel.empty()) break;
+        }
+
+        std::vector<u64> targets;
+        for (int i = 0; i < 8; i++) targets.push_back(refs[rng() % refs.size()].hash);
+        if (!novel.empty()) targets.push_back(spawnerNameHash(novel));
+        for (int i = 0; i < 8; i++) targets.push_back(((u64)rng() << 32) | rng());
+
+        std::vector<NameMatch> fast, slow;
+        names.search(targets, 0, fast);
+        names.searchScalar(targets, slow);
+        bool same = fast.size() == slow.size();
+        for (size_t i = 0; same && i < fast.size(); i++)
+            same = fast[i].hash == slow[i].hash && fast[i].name == slow[i].name;
+        if (!same) {
+            fprintf(stderr, "NameTemplates::search disagrees with searchScalar\n");
+            return 1;
+        }
+        for (size_t i = 0; i < 9 && i < targets.size(); i++) {
+            bool found = std::any_of(fast.begin(), fast.end(), [&](const NameMatch& m) { return m.hash == targets[i]; });
+            if (!found) {
+                fprintf(stderr, "Name search missed %016llX\n", (unsigned long long)targets[i]);
+                return 1;
+            }
+        }
+        printf("%zu name templates, %llu candidates, e.g. %s\n\n", names.templates(),
+               (unsigned long long)names.candidates(), novel.c_str());
+
+        const u64 cands = names.candidates();
+        std::vector<NameMatch> out;
+        bench("names/scalar", cands, 0, [&] { out.clear(); doNotOptimize(names.searchScalar(targets, out)); });
+        bench("names/lanes-1t", cands, 0, [&] { out.clear(); doNotOptimize(names.search(targets, 1, out)); });
+        bench("names/lanes-all", cands, 0, [&] { out.clear(); doNotOptimize(names.search(targets, 0, out)); });
+    }
+
+    // --- Density heatmap ----------------------------------------------------
+    {
+        // Full-resolution images of the 2160 px maps, then 100k spawners in
+        // Gaussian blobs over Lysandre Labs, on every core and on one
+        std::vector<SpawnerEntry> synth;
+        synth.reserve(100000);
+        std::normal_distribution<float> blob(0.0f, 4.0f);
+        while (synth.size() < 100000) {
+            float cx = (float)(rng() % 140) - 70, cz = (float)(rng() % 160) - 80;
+            for (int i = 0; i < 500; i++)
+                synth.push_back({rng(), cx + blob(rng), 0, cz + blob(rng), 1, ""});
+        }
+
+        struct HeatCase { std::string name; const std::vector<SpawnerEntry>* set; int map; };
+        std::vector<HeatCase> cases;
+        for (int m = 0; m < mapCount; m++) {
+            const MapTransform& tr = g_profile.maps[m].transform;
+            if (tr.texW != 2160 || tr.texH != 2160) continue;
+            std::string file = g_profile.maps[m].image;
+            file = file.substr(file.find_last_of('/') + 1);
+            cases.push_back({file.substr(0, file.find('.')), &spawners, m});
+        }
+        cases.push_back({"synth100k", &synth, 1});
+
+        std::vector<int> threadCounts = {heatmapThreads()};
+        if (threadCounts[0] > 1) threadCounts.push_back(1);
+        std::vector<u32> img;
+        for (const HeatCase& hc : cases) {
+            const MapTransform& tr = g_profile.maps[hc.map].transform;
+            for (int threads : threadCounts) {
+                char name[64];
+                snprintf(name, sizeof(name), "Heatmap/%s-2160-%dt", hc.name.c_str(), threads);
+                if (!benchSelected(g_opt, name)) continue;
+                HeatmapTiming t = {};
+                u64 splat = 0, blur = 0, color = 0, runs = 0;
+                bench(name, 1, 0, [&] {
+                    computeHeatmap(*hc.set, hc.map, tr, 2160, 2160, threads, img, &t);
+                    splat += t.splatNs; blur += t.blurNs; color += t.colorNs; runs++;
+                });
+                printf("    splat %.2f ms  blur %.2f ms  color %.2f ms\n",
+                       splat / 1e6 / runs, blur / 1e6 / runs, color / 1e6 / runs);
+            }
+        }
+    }
+
+    // --- Map transform ------------------------------------------------------
+    bench("MapTransform/all-spawners", spawners.size(), 0, [&] {
+        double acc = 0;
+        for (const auto& sp : spawners) {
+            const MapTransform& tr = g_profile.maps[sp.mapIdx].transform;
+            acc += tr.convertX(sp.x) + tr.convertZ(sp.z);
+        }
+        doNotOptimize(acc);
+    });
+
+    if (g_opt.jsonPath && !writeBenchJson(g_opt.jsonPath, "micro", g_results)) {
+        fprintf(stderr, "Failed to write %s\n", g_opt.jsonPath);
+        return 1;
+    }
+    return 0;
+}
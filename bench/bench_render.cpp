@@ -0,0 +1,245 @@
+#include "bench.h"
+#include "app.h"
+#include "config.h"
+#include "heatmap.h"
+#include "paths.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+
+// ============================================================
+// Render-loop benchmark (software renderer, no GPU or window)
+// ============================================================
+//
+//   bench_render [--frames <n>] [--filter <s>] [--json <file>] [--quick]
+//
+// Every frame runs the app's real renderFrame() into an offscreen
+// 1280x720 surface. Each scenario updates UI state between frames
+// the same way the input loop in main.cpp does.
+
+struct Scenario {
+    const char* name;
+    std::function<void()> setup;
+    std::function<void(int frame)> step;   // called before each frame
+};
+
+struct FrameStats {
+    std::string name;
+    int    frames;
+    double minMs, p50Ms, p90Ms, p99Ms, maxMs, meanMs;
+    double allocsPerFrame;
+};
+
+static void resetState() {
+    g_entries.clear();
+    g_selIdx = 0;
+    g_scrollOff = 0;
+    g_selSpawner = nullptr;
+    g_showAbout = false;
+    g_cursorMode = false;
+    g_showLabels = false;
+    g_showHeatmap = false;
+    g_showRegions = false;
+    g_showRoute = false;
+    setBrowseMode(false);
+    setMapFilter(FILTER_OFF);
+    g_config.mapFilterHide = false;
+    g_config.mapFilter.clear();
+    g_mapZoom = 1;
+    g_statusMsg = "Press A to read game memory";
+}
+
+// Entries with random spawners and species, as a stash read would produce.
+static void fillEntries(int count, std::mt19937& rng) {
+    g_entries.clear();
+    for (int i = 0; i < count; i++) {
+        u16 ndex = (u16)(1 + rng() % 1025);
+        g_entries.push_back({g_spawners[rng() % g_spawners.size()].hash, ndex, ndex, true});
+    }
+    g_entriesVersion++;
+}
+
+// One entry per map so that stepping the selection switches maps every frame.
+static void fillEntriesPerMap() {
+    g_entries.clear();
+    for (int m = 0; m < (int)g_profile.maps.size(); m++) {
+        for (const auto& sp : g_spawners) {
+            if (sp.mapIdx != m) continue;
+            g_entries.push_back({sp.hash, (u16)(25 + m), (u16)(25 + m), true});
+            break;
+        }
+    }
+}
+
+// Steps the map zoom in to the maximum and back out, one step per 5 frames.
+static void zoomStep(int frame) {
+    if (frame % 5 == 0) zoomMap((frame / 5) % 10 < 5 ? +1 : -1);
+}
+
+// Bounces the selection through the list like held D-pad presses.
+static void scrollStep(int frame) {
+    int n = (int)g_entries.size();
+    if (n < 2) return;
+    int period = 2 * (n - 1);
+    int pos = frame % period;
+    g_selIdx = pos < n ? pos : period - pos;
+    updateSelection();
+}
+
+// Types a location into the spawner browser and erases it again, one key
+// per frame, moving the selection down a row every frame.
+static const char BROWSE_TYPED[] = "wild zone 1";
+static int g_browseTyped = 0;
+
+static void browseSetup() {
+    setBrowseMode(true);
+    for (int i = 0; i < 64; i++) browseErase();
+    g_browseTyped = 0;
+}
+
+static void browseStep(int frame) {
+    const int n = (int)sizeof(BROWSE_TYPED) - 1;
+    int period = 2 * n;
+    int pos = frame % period;
+    int want = pos < n ? pos : period - pos;
+    for (; g_browseTyped < want; g_browseTyped++) browseType(BROWSE_TYPED[g_browseTyped]);
+    for (; g_browseTyped > want; g_browseTyped--) browseErase();
+    browseMove(+1);
+}
+
+static FrameStats runScenario(const Scenario& sc, int frames) {
+    resetState();
+    sc.setup();
+    updateSelection();
+
+    // Warm the sprite/texture caches outside the measurement
+    for (int i = 0; i < 8; i++) { sc.step(i); renderFrame(); SDL_RenderPresent(g_renderer); }
+
+    std::vector<double> ms(frames);
+    u64 a0 = benchAllocCount();
+    for (int f = 0; f < frames; f++) {
+        sc.step(f);
+        u64 t0 = benchNowNs();
+        renderFrame();
+        SDL_RenderPresent(g_renderer);
+        ms[f] = (double)(benchNowNs() - t0) / 1e6;
+    }
+    u64 allocs = benchAllocCount() - a0;
+
+    FrameStats st;
+    st.name = sc.name;
+    st.frames = frames;
+    double sum = 0;
+    for (double v : ms) sum += v;
+    std::sort(ms.begin(), ms.end());
+    auto pct = [&](double p) { return ms[std::min(frames - 1, (int)(p * frames))]; };
+    st.minMs  = ms.front();
+    st.p50Ms  = pct(0.50);
+    st.p90Ms  = pct(0.90);
+    st.p99Ms  = pct(0.99);
+    st.maxMs  = ms.back();
+    st.meanMs = sum / frames;
+    st.allocsPerFrame = (double)allocs / frames;
+    return st;
+}
+
+static bool writeFrameJson(const char* path, const std::vector<FrameStats>& stats) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\n  \"suite\": \"render\",\n  \"version\": \"%s\",\n  \"results\": [\n", APP_VERSION);
+    for (size_t i = 0; i < stats.size(); i++) {
+        const FrameStats& s = stats[i];
+        fprintf(f, "    {\"name\": \"%s\", \"frames\": %d, \"min_ms\": %.4f, \"p50_ms\": %.4f, "
+                   "\"p90_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f, \"mean_ms\": %.4f, "
+                   "\"allocs_per_frame\": %.2f}%s\n",
+                s.name.c_str(), s.frames, s.minMs, s.p50Ms, s.p90Ms, s.p99Ms, s.maxMs, s.meanMs,
+                s.allocsPerFrame, i + 1 < stats.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions opt = parseBenchArgs(argc, argv);
+    int frames = opt.quick ? 30 : 300;
+    for (int i = 1; i + 1 < argc; i++)
+        if (!strcmp(argv[i], "--frames")) frames = std::max(1, atoi(argv[++i]));
+
+    setenv("SDL_VIDEODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_VIDEO) < 0 || IMG_Init(IMG_INIT_PNG) == 0 || TTF_Init() < 0) {
+        fprintf(stderr, "SDL init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    g_renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!g_renderer) {
+        fprintf(stderr, "Software renderer failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+
+    plInitialize(PlServiceType_User);
+    if (!initFonts()) {
+        fprintf(stderr, "Font load failed (set SSLM_FONT)\n");
+        return 1;
+    }
+    loadData();
+    if (g_spawners.empty()) {
+        fprintf(stderr, "No spawner data under " ROMFS_ROOT "\n");
+        return 1;
+    }
+
+    std::mt19937 rng(4242);
+    const Scenario scenarios[] = {
+        {"empty",        [] {},                             [](int) {}},
+        {"stash10",      [&] { fillEntries(10, rng); },     [](int) {}},
+        {"scroll10",     [&] { fillEntries(10, rng); },     scrollStep},
+        {"about",        [&] { fillEntries(10, rng); g_showAbout = true; }, [](int) {}},
+        {"mapswitch",    [] { fillEntriesPerMap(); },       scrollStep},
+        {"stash1000",    [&] { fillEntries(1000, rng); },   [](int) {}},
+        {"scroll1000",   [&] { fillEntries(1000, rng); },   scrollStep},
+        {"zoom",         [&] { fillEntries(100, rng); },    zoomStep},
+        {"labels",       [&] { fillEntries(10, rng); g_showLabels = true; }, zoomStep},
+        {"heatmap",      [&] { fillEntries(10, rng); stopHeatmapBuild(); g_showHeatmap = true; }, zoomStep},
+        {"regions",      [&] { fillEntries(10, rng); g_showRegions = true; }, scrollStep},
+        {"route100",     [&] { fillEntries(100, rng); g_showRoute = true; }, zoomStep},
+        {"routefilter",  [&] { fillEntries(10, rng); g_config.mapFilter = "loc:wild zone";
+                               setMapFilter(FILTER_CUSTOM); g_showRoute = true; }, zoomStep},
+        {"browser",      [&] { fillEntries(10, rng); browseSetup(); }, browseStep},
+        {"filter",       [&] { fillEntries(10, rng); setMapFilter(FILTER_STASH); }, zoomStep},
+        {"filterloc",    [&] { fillEntries(10, rng); setMapFilter(FILTER_LOCATION); }, scrollStep},
+        {"filterhide",   [&] { fillEntries(10, rng); g_config.mapFilterHide = true;
+                               g_config.mapFilter = "!loc:wild zone"; setMapFilter(FILTER_CUSTOM); }, zoomStep},
+    };
+
+    printf("%-14s %7s %9s %9s %9s %9s %9s %9s %12s\n",
+           "scenario", "frames", "min ms", "p50 ms", "p90 ms", "p99 ms", "max ms", "mean ms", "alloc/frame");
+    std::vector<FrameStats> stats;
+    for (const Scenario& sc : scenarios) {
+        if (!benchSelected(opt, sc.name)) continue;
+        FrameStats st = runScenario(sc, frames);
+        printf("%-14s %7d %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %12.1f\n",
+               st.name.c_str(), st.frames, st.minMs, st.p50Ms, st.p90Ms, st.p99Ms,
+               st.maxMs, st.meanMs, st.allocsPerFrame);
+        fflush(stdout);
+        stats.push_back(st);
+    }
+
+    int rc = 0;
+    if (opt.jsonPath && !writeFrameJson(opt.jsonPath, stats)) {
+        fprintf(stderr, "Failed to write %s\n", opt.jsonPath);
+        rc = 1;
+    }
+    resetState();
+    cleanup();
+    SDL_FreeSurface(target);
+    plExit();
+    return rc;
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+// ============================================================
+// libnx shim for the host (Linux) build
+// ============================================================
+//
+// Provides just the subset of libnx used by the app: integer types,
+// Result codes, svc/romfs/pl/pad/applet entry points. Input and the
+// shared font are emulated with desktop SDL2 in switch_shim.cpp.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <stdbool.h>
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t   s8;
+typedef int16_t  s16;
+typedef int32_t  s32;
+typedef int64_t  s64;
+
+typedef u32 Result;
+#define R_SUCCEEDED(res) ((res) == 0)
+#define R_FAILED(res)    ((res) != 0)
+#define MAKERESULT(module, description) \
+    ((((module) & 0x1FF)) | ((description) & 0x1FFF) << 9)
+#define Module_Libnx 345
+
+typedef u32 Handle;
+typedef struct { u32 session; } Service;
+typedef struct { u32 revent; } Event;
+typedef struct {
+    u64 addr;
+    u64 size;
+    u32 type;
+    u32 attr;
+    u32 perm;
+    u32 ipc_refcount;
+    u32 device_refcount;
+    u32 padding;
+} MemoryInfo;
+
+typedef enum {
+    Perm_None = 0,
+    Perm_R    = 1,
+    Perm_W    = 2,
+    Perm_X    = 4,
+    Perm_Rw   = Perm_R | Perm_W,
+    Perm_Rx   = Perm_R | Perm_X,
+} Permission;
+
+// svc: the process may run on every online CPU; thread placement is
+// left to the OS
+#define CUR_PROCESS_HANDLE 0xFFFF8001
+#define CUR_THREAD_HANDLE  0xFFFF8000
+typedef enum { InfoType_CoreMask = 0 } InfoType;
+static inline Result svcGetInfo(u64* out, u32 id0, Handle, u64) {
+    if (id0 != InfoType_CoreMask) return 1;
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    *out = n >= 64 ? ~0ULL : (1ULL << (n > 0 ? n : 1)) - 1;
+    return 0;
+}
+static inline Result svcSetThreadCoreMask(Handle, s32, u32) { return 0; }
+
+// romfs (assets are read straight from ROMFS_ROOT on the host)
+static inline Result romfsInit(void) { return 0; }
+static inline Result romfsExit(void) { return 0; }
+
+// pl (shared font)
+typedef enum { PlServiceType_User = 0 } PlServiceType;
+typedef enum { PlSharedFontType_Standard = 0 } PlSharedFontType;
+typedef struct {
+    u32 type;
+    u32 offset;
+    u32 size;
+    void* address;
+} PlFontData;
+
+Result plInitialize(PlServiceType service_type);
+void   plExit(void);
+Result plGetSharedFontByType(PlFontData* font, PlSharedFontType SharedFontType);
+
+// applet
+bool appletMainLoop(void);
+
+// hid / pad
+typedef enum {
+    HidNpadButton_A      = 1ULL << 0,
+    HidNpadButton_B      = 1ULL << 1,
+    HidNpadButton_X      = 1ULL << 2,
+    HidNpadButton_Y      = 1ULL << 3,
+    HidNpadButton_StickL = 1ULL << 4,
+    HidNpadButton_StickR = 1ULL << 5,
+    HidNpadButton_L      = 1ULL << 6,
+    HidNpadButton_R      = 1ULL << 7,
+    HidNpadButton_ZL     = 1ULL << 8,
+    HidNpadButton_ZR     = 1ULL << 9,
+    HidNpadButton_Plus   = 1ULL << 10,
+    HidNpadButton_Minus  = 1ULL << 11,
+    HidNpadButton_Left   = 1ULL << 12,
+    HidNpadButton_Up     = 1ULL << 13,
+    HidNpadButton_Right  = 1ULL << 14,
+    HidNpadButton_Down   = 1ULL << 15,
+} HidNpadButton;
+
+#define HidNpadStyleSet_NpadStandard 0x1F
+
+#define JOYSTICK_MAX 0x7FFF
+
+typedef struct {
+    s32 x;
+    s32 y;
+} HidAnalogStickState;
+
+typedef struct {
+    u64 buttons_cur;
+    u64 buttons_old;
+    HidAnalogStickState sticks[2];
+} PadState;
+
+void padConfigureInput(u32 max_players, u32 style_set);
+void padInitializeDefault(PadState* pad);
+void padUpdate(PadState* pad);
+
+static inline u64 padGetButtons(const PadState* pad) { return pad->buttons_cur; }
+static inline u64 padGetButtonsDown(const PadState* pad) {
+    return ~pad->buttons_old & pad->buttons_cur;
+}
+static inline HidAnalogStickState padGetStickPos(const PadState* pad, unsigned int i) {
+    return pad->sticks[i];
+}
+
+// touch screen
+typedef struct {
+    u64 delta_time;
+    u32 attributes;
+    u32 finger_id;
+    u32 x;
+    u32 y;
+    u32 diameter_x;
+    u32 diameter_y;
+    u32 rotation_angle;
+    u32 reserved;
+} HidTouchState;
+
+typedef struct {
+    u64 sampling_number;
+    s32 count;
+    u32 reserved;
+    HidTouchState touches[16];
+} HidTouchScreenState;
+
+void   hidInitializeTouchScreen(void);
+size_t hidGetTouchScreenStates(HidTouchScreenState* states, size_t count);
+
+// keyboard (USB on the console, the host keyboard here)
+typedef enum {
+    HidKeyboardKey_A         = 4,
+    HidKeyboardKey_Z         = 29,
+    HidKeyboardKey_D1        = 30,
+    HidKeyboardKey_D9        = 38,
+    HidKeyboardKey_D0        = 39,
+    HidKeyboardKey_Return    = 40,
+    HidKeyboardKey_Escape    = 41,
+    HidKeyboardKey_Backspace = 42,
+    HidKeyboardKey_Tab       = 43,
+    HidKeyboardKey_Space     = 44,
+} HidKeyboardKey;
+
+typedef struct {
+    u64 sampling_number;
+    u64 modifiers;
+    u32 attributes;
+    u32 reserved;
+    u64 keys[4];
+} HidKeyboardState;
+
+static inline bool hidKeyboardStateGetKey(const HidKeyboardState* state, HidKeyboardKey key) {
+    return (state->keys[key / 64] >> (key % 64)) & 1;
+}
+
+void   hidInitializeKeyboard(void);
+size_t hidGetKeyboardStates(HidKeyboardState* states, size_t count);
+
+// software keyboard (unavailable on the host)
+typedef struct {
+    u8 reserved[0x100];
+} SwkbdConfig;
+
+Result swkbdCreate(SwkbdConfig* c, s32 max_dictwords);
+void   swkbdClose(SwkbdConfig* c);
+void   swkbdConfigMakePresetDefault(SwkbdConfig* c);
+void   swkbdConfigSetGuideText(SwkbdConfig* c, const char* str);
+void   swkbdConfigSetInitialText(SwkbdConfig* c, const char* str);
+Result swkbdShow(SwkbdConfig* c, char* out_string, size_t out_string_size);
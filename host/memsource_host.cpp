@@ -0,0 +1,639 @@
+#include "memsource.h"
+#include "memcapture.h"
+#include "namehash.h"
+#include "player.h"
+#include "spawners.h"
+#include "stash.h"
+#include "synth.h"
+#include "timing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================
+// Player Path
+// ============================================================
+//
+// Where the player is at a given time: straight legs between
+// timestamped waypoints, looping from the last back to the first.
+// Text files hold one "<seconds> <x> <y> <z>" line per waypoint.
+
+struct PlayerPath {
+    struct Point { double t; PlayerPos pos; };
+    std::vector<Point> points;   // t ascending, points[0].t == 0
+
+    bool load(const char* path) {
+        FILE* f = fopen(path, "r");
+        if (!f) return false;
+        char line[256];
+        points.clear();
+        while (fgets(line, sizeof(line), f)) {
+            Point p;
+            if (line[0] == '#' || sscanf(line, "%lf %f %f %f", &p.t, &p.pos.x, &p.pos.y, &p.pos.z) != 4)
+                continue;
+            if (!points.empty() && p.t <= points.back().t) continue;
+            points.push_back(p);
+        }
+        fclose(f);
+        if (points.empty()) return false;
+        double t0 = points[0].t;
+        for (Point& p : points) p.t -= t0;
+        return true;
+    }
+
+    // Waypoints at `speed` units per second, closing the loop
+    void walk(const std::vector<PlayerPos>& stops, double speed) {
+        points.clear();
+        double t = 0;
+        for (size_t i = 0; i <= stops.size() && !stops.empty(); i++) {
+            const PlayerPos& p = stops[i % stops.size()];
+            if (i) t += std::hypot(p.x - points.back().pos.x, p.z - points.back().pos.z) / speed + 1.0;
+            points.push_back({t, p});
+        }
+    }
+
+    PlayerPos at(double t) const {
+        if (points.size() < 2 || points.back().t <= 0) return points.empty() ? PlayerPos{} : points[0].pos;
+        t = std::fmod(t, points.back().t);
+        auto it = std::upper_bound(points.begin(), points.end(), t,
+                                   [](double v, const Point& p) { return v < p.t; });
+        const Point& b = *it;
+        const Point& a = *std::prev(it);
+        float f = (float)((t - a.t) / (b.t - a.t));
+        return {a.pos.x + (b.pos.x - a.pos.x) * f, a.pos.y + (b.pos.y - a.pos.y) * f,
+                a.pos.z + (b.pos.z - a.pos.z) * f};
+    }
+};
+
+// ============================================================
+// Memory Image
+// ============================================================
+//
+// Sparse snapshot of the game's address space: a set of
+// non-overlapping regions keyed by start address. When playerAddr is
+// set, reads of the 12 bytes there return playerPath at the time of
+// the read, so the player walks while the rest of the image stands
+// still.
+
+static constexpr Result RC_UNMAPPED     = MAKERESULT(Module_Libnx, 1);
+static constexpr Result RC_NOT_CAPTURED = MAKERESULT(Module_Libnx, 2);
+static constexpr Result RC_NO_CHEAT     = MAKERESULT(Module_Libnx, 3);
+static constexpr char   DUMP_MAGIC[8] = {'S','S','L','M','D','M','P','1'};
+
+class ImageMemorySource : public MemorySource {
+public:
+    DmntCheatProcessMetadata meta = {};
+    std::map<u64, std::vector<u8>> regions;
+    u64        playerAddr = 0;
+    PlayerPath playerPath;
+
+    const char* open() override { return nullptr; }
+    void close() override {}
+
+    Result getMetadata(DmntCheatProcessMetadata* out) override {
+        *out = meta;
+        return 0;
+    }
+
+    Result read(u64 address, void* buffer, size_t size) override {
+        auto it = regions.upper_bound(address);
+        if (it == regions.begin()) return RC_UNMAPPED;
+        --it;
+        u64 off = address - it->first;
+        if (off + size > it->second.size()) return RC_UNMAPPED;
+        memcpy(buffer, it->second.data() + off, size);
+        if (playerAddr && address < playerAddr + sizeof(PlayerPos) && playerAddr < address + size) {
+            if (!m_pathStartNs) m_pathStartNs = nowNs();
+            PlayerPos pos = playerPath.at((double)(nowNs() - m_pathStartNs) / 1e9);
+            u64 lo = std::max(address, playerAddr);
+            u64 hi = std::min(address + size, playerAddr + sizeof(PlayerPos));
+            memcpy((u8*)buffer + (lo - address), (const u8*)&pos + (lo - playerAddr), hi - lo);
+        }
+        return 0;
+    }
+
+    // Regions as mappings; the gap up to the next region reads as unmapped.
+    // Dumps carry no permissions: the region at the NSO base is its .text.
+    Result queryMemory(u64 address, MemoryInfo* out) override {
+        memset(out, 0, sizeof(*out));
+        auto it = regions.upper_bound(address);
+        if (it != regions.begin()) {
+            auto prev = std::prev(it);
+            if (address < prev->first + prev->second.size()) {
+                out->addr = prev->first;
+                out->size = prev->second.size();
+                out->perm = prev->first == meta.main_nso_extents.base ? Perm_Rx : Perm_Rw;
+                out->type = 1;
+                return 0;
+            }
+        }
+        out->addr = address;
+        out->size = (it != regions.end() ? it->first : ~0ull) - address;
+        return 0;
+    }
+
+    Result pause() override  { return 0; }
+    Result resume() override { return 0; }
+
+    Result addCheat(const DmntCheatDefinition& def, u32* outId) override {
+        *outId = m_nextCheatId++;
+        m_cheats[*outId] = def;
+        return 0;
+    }
+
+    Result removeCheat(u32 id) override {
+        return m_cheats.erase(id) ? 0 : RC_NO_CHEAT;
+    }
+
+    // Every register read stands in for a game frame: run the cheats first
+    Result readStaticRegister(u8 which, u64* out) override {
+        for (auto& c : m_cheats) runCheat(c.second);
+        *out = m_static[which];
+        return 0;
+    }
+
+    Result writeStaticRegister(u8 which, u64 value) override {
+        m_static[which] = value;
+        return 0;
+    }
+
+    void map(u64 address, const void* data, size_t size) {
+        const u8* p = (const u8*)data;
+        regions[address].assign(p, p + size);
+    }
+
+    void mapU64(u64 address, u64 value) { map(address, &value, sizeof(value)); }
+
+    // Writes into the region holding [address, address + size), or maps a new one
+    void poke(u64 address, const void* data, size_t size) {
+        auto it = regions.upper_bound(address);
+        if (it != regions.begin()) {
+            --it;
+            if (address - it->first + size <= it->second.size()) {
+                memcpy(it->second.data() + (address - it->first), data, size);
+                return;
+            }
+        }
+        map(address, data, size);
+    }
+
+    bool load(const char* path) {
+        FILE* f = fopen(path, "rb");
+        if (!f) return false;
+        char magic[8];
+        u32 count = 0;
+        bool ok = fread(magic, 1, 8, f) == 8 && memcmp(magic, DUMP_MAGIC, 8) == 0 &&
+                  fread(&meta, sizeof(meta), 1, f) == 1 &&
+                  fread(&count, sizeof(count), 1, f) == 1;
+        for (u32 i = 0; ok && i < count; i++) {
+            u64 hdr[2];
+            ok = fread(hdr, sizeof(hdr), 1, f) == 1;
+            if (!ok) break;
+            std::vector<u8>& r = regions[hdr[0]];
+            r.resize(hdr[1]);
+            ok = fread(r.data(), 1, r.size(), f) == r.size();
+        }
+        fclose(f);
+        return ok;
+    }
+
+    bool save(const char* path) const {
+        FILE* f = fopen(path, "wb");
+        if (!f) return false;
+        u32 count = (u32)regions.size();
+        fwrite(DUMP_MAGIC, 1, 8, f);
+        fwrite(&meta, sizeof(meta), 1, f);
+        fwrite(&count, sizeof(count), 1, f);
+        for (const auto& r : regions) {
+            u64 hdr[2] = {r.first, (u64)r.second.size()};
+            fwrite(hdr, sizeof(hdr), 1, f);
+            fwrite(r.second.data(), 1, r.second.size(), f);
+        }
+        return fclose(f) == 0;
+    }
+
+private:
+    // Subset of the Atmosphere cheat VM: the opcodes buildStashCheat emits
+    // (type 5 loads, type 7 static arithmetic, C3 static registers).
+    // Anything else ends the program.
+    void runCheat(const DmntCheatDefinition& def) {
+        u64 reg[16] = {};
+        u32 n = std::min<u32>(def.num_opcodes, 0x100);
+        for (u32 pc = 0; pc < n;) {
+            u32 w = def.opcodes[pc++];
+            switch (w >> 28) {
+                case 0x5: {
+                    if (pc >= n) return;
+                    u32 width = (w >> 24) & 0xF, mtype = (w >> 20) & 0xF;
+                    u32 r = (w >> 16) & 0xF;
+                    bool fromReg = ((w >> 12) & 0xF) != 0;
+                    u64 rel = ((u64)(w & 0xFF) << 32) | def.opcodes[pc++];
+                    u64 addr = fromReg ? reg[r] + rel : regionBase(mtype) + rel;
+                    u64 v = 0;
+                    if (width > 8 || R_FAILED(read(addr, &v, width))) v = 0;
+                    reg[r] = v;
+                    break;
+                }
+                case 0x7: {
+                    if (pc >= n) return;
+                    u32 r = (w >> 16) & 0xF, math = (w >> 12) & 0xF;
+                    u64 v = def.opcodes[pc++];
+                    switch (math) {
+                        case 0: reg[r] += v; break;
+                        case 1: reg[r] -= v; break;
+                        case 2: reg[r] *= v; break;
+                        case 3: reg[r] <<= v; break;
+                        case 4: reg[r] >>= v; break;
+                        default: return;
+                    }
+                    break;
+                }
+                case 0xC: {
+                    if ((w >> 24) != 0xC3) return;
+                    u32 sidx = (w >> 4) & 0xFF, r = w & 0xF;
+                    if (sidx < 0x80) reg[r] = m_static[sidx];
+                    else             m_static[sidx] = reg[r];
+                    break;
+                }
+                default:
+                    return;
+            }
+        }
+    }
+
+    u64 regionBase(u32 mtype) const {
+        switch (mtype) {
+            case 0:  return meta.main_nso_extents.base;
+            case 1:  return meta.heap_extents.base;
+            case 2:  return meta.alias_extents.base;
+            default: return meta.address_space_extents.base;
+        }
+    }
+
+    std::map<u32, DmntCheatDefinition> m_cheats;
+    u32 m_nextCheatId = 1;
+    u64 m_pathStartNs = 0;
+    u64 m_static[256] = {};
+};
+
+// ============================================================
+// Synthetic Stash
+// ============================================================
+//
+// Lays out main NSO + heap so that basePointer -> pointer chain
+// resolves to a stash block from synthesizeStashBlock(). The NSO gets
+// a .text of random words holding one ADRP + LDR of the base pointer
+// among decoy loads, and a .data page around the global, so the
+// signature scan has something realistic to chew on.
+
+static constexpr u64 SYNTH_MAIN_BASE = 0x0008000000ULL;
+static constexpr u64 SYNTH_HEAP_BASE = 0x0020000000ULL;
+static constexpr u64 SYNTH_TEXT_SIZE = 0x400000;
+static constexpr u64 SYNTH_DATA_SPAN = 0x2000;     // .data bytes around the global
+
+// ADRP x8, target@page ; LDR x8, [x8, target@pageoff]
+static void emitPointerLoad(u8* text, u64 pc, u64 target) {
+    s64 pages = (s64)((target & ~0xFFFull) - (pc & ~0xFFFull)) >> 12;
+    u32 adrp = 0x90000000 | (((u32)pages & 3) << 29) | ((((u32)pages >> 2) & 0x7FFFF) << 5) | 8;
+    u32 ldr  = 0xF9400000 | ((u32)((target & 0xFFF) / 8) << 10) | (8 << 5) | 8;
+    memcpy(text, &adrp, 4);
+    memcpy(text + 4, &ldr, 4);
+}
+
+static void synthesizeStash(ImageMemorySource& img, int count, u32 seed, bool unknownBuild,
+                            const char* unknownSpawner) {
+    const GameVersion& ver = g_profile.versions[0];
+    std::mt19937 rng(seed);
+
+    img.meta.title_id = g_profile.titleId;
+    img.meta.main_nso_extents = {SYNTH_MAIN_BASE, ver.basePointer + SYNTH_DATA_SPAN};
+    img.meta.heap_extents     = {SYNTH_HEAP_BASE, 0x100000};
+    memcpy(img.meta.main_nso_build_id, ver.build_id, 8);
+    if (unknownBuild) img.meta.main_nso_build_id[0] ^= 0xFF;
+
+    const u64 global   = SYNTH_MAIN_BASE + ver.basePointer;
+    const u64 dataBase = global - SYNTH_DATA_SPAN / 2;
+    std::vector<u8> text(SYNTH_TEXT_SIZE), data(SYNTH_DATA_SPAN);
+    for (size_t i = 0; i < text.size(); i += 4) {
+        u32 w = rng();
+        memcpy(&text[i], &w, 4);
+    }
+    for (int i = 0; i < 64; i++) {
+        u64 pc = (rng() % (SYNTH_TEXT_SIZE / 4 - 1)) * 4;
+        emitPointerLoad(&text[pc], SYNTH_MAIN_BASE + pc, dataBase + (rng() % (SYNTH_DATA_SPAN / 8)) * 8);
+    }
+    u64 pc = (rng() % (SYNTH_TEXT_SIZE / 4 - 1)) * 4;
+    emitPointerLoad(&text[pc], SYNTH_MAIN_BASE + pc, global);
+    img.map(SYNTH_MAIN_BASE, text.data(), text.size());
+
+    // Pointer chain: one heap node per dereference, stash after the last node
+    u64 node = SYNTH_HEAP_BASE;
+    memcpy(&data[global - dataBase], &node, sizeof(u64));
+    img.map(dataBase, data.data(), data.size());
+    const u64* chain = g_profile.chain;
+    const int last = g_profile.chainLen - 1;
+    u64 loc = node + chain[0];
+    node += 0x1000;
+    for (int i = 1; i < last; i++) {
+        img.mapU64(loc, node);
+        loc = node + chain[i];
+        node += 0x1000;
+    }
+    u64 stashAddr = node;
+    img.mapU64(loc, stashAddr - chain[last]);
+
+    std::vector<u8> stash(g_profile.stashSize);
+    synthesizeStashBlock(stash.data(), count, rng);
+    if (unknownSpawner && count > 0) {
+        u64 hash = spawnerNameHash(unknownSpawner);
+        memcpy(stash.data(), &hash, sizeof(u64));
+    }
+    img.map(stashAddr, stash.data(), stash.size());
+}
+
+// Maps profile.playerChain (when the profile has one) into the image,
+// ending at a position block that walks playerPath, and
+// profile.playerMapChain ending at the first map's zone id.
+static constexpr u64    SYNTH_PLAYER_NODES = SYNTH_HEAP_BASE + 0x80000;
+static constexpr u64    SYNTH_ZONE_NODES   = SYNTH_HEAP_BASE + 0x200000;
+static constexpr double SYNTH_PLAYER_SPEED = 12.0;   // world units per second
+
+static void synthesizePlayer(ImageMemorySource& img, u32 seed) {
+    if (g_profile.playerChainLen == 0) return;
+    const u64* chain = g_profile.playerChain;
+    u64 loc = img.meta.main_nso_extents.base + chain[0];
+    u64 node = SYNTH_PLAYER_NODES;
+    for (int i = 1; i < g_profile.playerChainLen; i++) {
+        img.poke(loc, &node, sizeof(node));
+        loc = node + chain[i];
+        node += 0x10000;
+    }
+    img.playerAddr = loc;
+
+    // Default walk: a loop through a few spawners of the first map
+    if (img.playerPath.points.empty()) {
+        std::mt19937 rng(seed);
+        std::vector<PlayerPos> stops;
+        std::vector<const SpawnerEntry*> onMap;
+        for (const SpawnerEntry& sp : g_spawners)
+            if (sp.mapIdx == 0) onMap.push_back(&sp);
+        for (int i = 0; i < 6 && !onMap.empty(); i++) {
+            const SpawnerEntry* sp = onMap[rng() % onMap.size()];
+            stops.push_back({sp->x, sp->y, sp->z});
+        }
+        img.playerPath.walk(stops, SYNTH_PLAYER_SPEED);
+    }
+    PlayerPos start = img.playerPath.at(0);
+    img.poke(loc, &start, sizeof(start));
+
+    if (g_profile.playerMapChainLen == 0) return;
+    const u64* zoneChain = g_profile.playerMapChain;
+    loc = img.meta.main_nso_extents.base + zoneChain[0];
+    node = SYNTH_ZONE_NODES;
+    bool shared = true;   // links in common with playerChain keep its nodes
+    for (int i = 1; i < g_profile.playerMapChainLen; i++) {
+        shared = shared && i < g_profile.playerChainLen && zoneChain[i - 1] == chain[i - 1];
+        u64 target = SYNTH_PLAYER_NODES + 0x10000 * (i - 1);
+        if (!shared) {
+            target = node;
+            img.poke(loc, &node, sizeof(node));
+            node += 0x10000;
+        }
+        loc = target + zoneChain[i];
+    }
+    u32 zone = g_profile.maps[0].zone >= 0 ? (u32)g_profile.maps[0].zone : 0;
+    img.poke(loc, &zone, sizeof(zone));
+}
+
+// ============================================================
+// Capture Replay
+// ============================================================
+//
+// Serves the responses of a CaptureMemorySource log. Each call is
+// matched to the next unused record with the same op (and address/size
+// for reads) at or after the replay cursor, which stays on the first
+// unused record: calls from the player tracker's thread interleave
+// with the app's differently on every run, and a record one of them
+// skips must still be there for the other. In real-time mode a response
+// is not returned before its recorded offset from the first call and
+// takes the recorded duration, reproducing the console's IPC timing.
+
+class ReplayMemorySource : public MemorySource {
+public:
+    bool load(const char* path, bool realTime) {
+        m_realTime = realTime;
+        FILE* f = fopen(path, "rb");
+        if (!f) return false;
+        char magic[8];
+        bool ok = fread(magic, 1, 8, f) == 8 && memcmp(magic, CAPTURE_MAGIC, 8) == 0;
+        CaptureRecord rec;
+        while (ok && fread(&rec, sizeof(rec), 1, f) == 1) {
+            Entry e = {rec, m_payload.size(), false};
+            u32 payload = payloadSize(rec);
+            m_payload.resize(m_payload.size() + payload);
+            if (payload && fread(&m_payload[e.payload], 1, payload, f) != payload) ok = false;
+            m_records.push_back(e);
+        }
+        fclose(f);
+        return ok;
+    }
+
+    const char* open() override {
+        const Entry* e = next(CAP_OPEN, 0, 0);
+        if (!e) return "Replay exhausted";
+        if (e->rec.result == 0) return nullptr;
+        m_openErr.assign((const char*)&m_payload[e->payload], e->rec.size);
+        return m_openErr.c_str();
+    }
+
+    void close() override { next(CAP_CLOSE, 0, 0); }
+
+    Result getMetadata(DmntCheatProcessMetadata* out) override {
+        const Entry* e = next(CAP_METADATA, 0, 0);
+        if (!e) return RC_NOT_CAPTURED;
+        if (R_SUCCEEDED(e->rec.result)) memcpy(out, &m_payload[e->payload], sizeof(*out));
+        return e->rec.result;
+    }
+
+    Result read(u64 address, void* buffer, size_t size) override {
+        const Entry* e = next(CAP_READ, address, (u32)size);
+        if (!e) return RC_NOT_CAPTURED;
+        if (R_SUCCEEDED(e->rec.result)) memcpy(buffer, &m_payload[e->payload], size);
+        return e->rec.result;
+    }
+
+    Result queryMemory(u64 address, MemoryInfo* out) override {
+        const Entry* e = next(CAP_QUERY, address, 0);
+        if (!e) return RC_NOT_CAPTURED;
+        if (R_SUCCEEDED(e->rec.result)) memcpy(out, &m_payload[e->payload], sizeof(*out));
+        return e->rec.result;
+    }
+
+    Result pause() override {
+        const Entry* e = next(CAP_PAUSE, 0, 0);
+        return e ? e->rec.result : RC_NOT_CAPTURED;
+    }
+
+    Result resume() override {
+        const Entry* e = next(CAP_RESUME, 0, 0);
+        return e ? e->rec.result : RC_NOT_CAPTURED;
+    }
+
+    Result addCheat(const DmntCheatDefinition&, u32* outId) override {
+        const Entry* e = next(CAP_ADD_CHEAT, 0, 0);
+        if (!e) return RC_NOT_CAPTURED;
+        if (R_SUCCEEDED(e->rec.result)) memcpy(outId, &m_payload[e->payload], sizeof(*outId));
+        return e->rec.result;
+    }
+
+    Result removeCheat(u32) override {
+        const Entry* e = next(CAP_REMOVE_CHEAT, 0, 0);
+        return e ? e->rec.result : RC_NOT_CAPTURED;
+    }
+
+    Result readStaticRegister(u8 which, u64* out) override {
+        const Entry* e = next(CAP_STATIC_READ, which, 0);
+        if (!e) return RC_NOT_CAPTURED;
+        if (R_SUCCEEDED(e->rec.result)) memcpy(out, &m_payload[e->payload], sizeof(*out));
+        return e->rec.result;
+    }
+
+    Result writeStaticRegister(u8, u64) override {
+        const Entry* e = next(CAP_STATIC_WRITE, 0, 0);
+        return e ? e->rec.result : RC_NOT_CAPTURED;
+    }
+
+private:
+    struct Entry {
+        CaptureRecord rec;
+        size_t payload;     // offset into m_payload
+        bool   used;
+    };
+
+    static u32 payloadSize(const CaptureRecord& rec) {
+        switch (rec.op) {
+            case CAP_OPEN:     return rec.result ? rec.size : 0;
+            case CAP_METADATA:
+            case CAP_READ:
+            case CAP_ADD_CHEAT:
+            case CAP_STATIC_READ:
+            case CAP_QUERY:       return R_SUCCEEDED(rec.result) ? rec.size : 0;
+            default:           return 0;
+        }
+    }
+
+    const Entry* next(CaptureOp op, u64 address, u32 size) {
+        for (size_t i = m_cursor; i < m_records.size(); i++) {
+            const CaptureRecord& r = m_records[i].rec;
+            if (m_records[i].used || r.op != op) continue;
+            if (op == CAP_READ && (r.address != address || r.size != size)) continue;
+            if ((op == CAP_STATIC_READ || op == CAP_QUERY) && r.address != address) continue;
+            m_records[i].used = true;
+            while (m_cursor < m_records.size() && m_records[m_cursor].used) m_cursor++;
+            if (m_realTime) pace(r);
+            return &m_records[i];
+        }
+        return nullptr;
+    }
+
+    void pace(const CaptureRecord& r) {
+        u64 now = nowNs();
+        if (!m_started) { m_originNs = now - r.startNs; m_started = true; }
+        u64 due = m_originNs + r.startNs;
+        if (due > now) std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+        std::this_thread::sleep_for(std::chrono::nanoseconds(r.durationNs));
+    }
+
+    std::vector<Entry> m_records;
+    std::vector<u8>    m_payload;
+    std::string        m_openErr;
+    size_t m_cursor   = 0;
+    bool   m_realTime = true;
+    bool   m_started  = false;
+    u64    m_originNs = 0;
+};
+
+// ============================================================
+// Factory
+// ============================================================
+//
+//   --dump <file>       replay a memory dump
+//   --synth <n>         synthesize a stash with n entries (default 10)
+//   --seed <n>          RNG seed for --synth
+//   --unknown-build     give the synthetic process a build ID missing from the profile
+//   --unknown-spawner <name>  give the first --synth entry the hash of <name>
+//                       (a spawner missing from the spawner files)
+//   --save-dump <file>  write the active image to a dump file
+//   --replay <file>     replay a capture log with its recorded timing
+//   --replay-fast       ... without waiting (as fast as the app asks)
+//   --capture <file>    record this session to a capture log
+//   --player-path <file>  move the player along "<seconds> x y z" waypoints
+//                       (--synth or --dump, with a player_chain in the profile)
+
+MemorySource* createMemorySource(int argc, char* argv[]) {
+    const char* dumpPath = nullptr;
+    const char* savePath = nullptr;
+    const char* replayPath = nullptr;
+    const char* capturePath = nullptr;
+    const char* playerPath = nullptr;
+    const char* unknownSpawner = nullptr;
+    bool replayFast = false;
+    bool unknownBuild = false;
+    int synthCount = 10;
+    u32 seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--replay-fast"))    { replayFast = true; continue; }
+        if (!strcmp(argv[i], "--unknown-build"))  { unknownBuild = true; continue; }
+        if (i + 1 >= argc) break;
+        if (!strcmp(argv[i], "--dump"))           dumpPath = argv[++i];
+        else if (!strcmp(argv[i], "--replay"))    replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--capture"))   capturePath = argv[++i];
+        else if (!strcmp(argv[i], "--synth"))     synthCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed"))      seed = (u32)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--save-dump")) savePath = argv[++i];
+        else if (!strcmp(argv[i], "--player-path")) playerPath = argv[++i];
+        else if (!strcmp(argv[i], "--unknown-spawner")) unknownSpawner = argv[++i];
+    }
+
+    MemorySource* src;
+    if (replayPath) {
+        ReplayMemorySource* rep = new ReplayMemorySource();
+        if (!rep->load(replayPath, !replayFast))
+            fprintf(stderr, "Failed to load capture: %s\n", replayPath);
+        src = rep;
+    } else {
+        ImageMemorySource* img = new ImageMemorySource();
+        if (playerPath && !img->playerPath.load(playerPath))
+            fprintf(stderr, "Failed to load player path: %s\n", playerPath);
+        if (dumpPath) {
+            if (!img->load(dumpPath))
+                fprintf(stderr, "Failed to load memory dump: %s\n", dumpPath);
+            u64 addr;
+            if (!img->playerPath.points.empty() && g_profile.playerChainLen &&
+                R_SUCCEEDED(resolvePlayerAddress(*img, img->meta.main_nso_extents.base, g_profile.playerChain,
+                                                 g_profile.playerChainLen, &addr)))
+                img->playerAddr = addr;
+        } else {
+            synthesizeStash(*img, synthCount, seed, unknownBuild, unknownSpawner);
+            synthesizePlayer(*img, seed);
+        }
+        if (savePath && !img->save(savePath))
+            fprintf(stderr, "Failed to write memory dump: %s\n", savePath);
+        src = img;
+    }
+    if (capturePath) {
+        MemorySource* cap = startCapture(src, capturePath);
+        if (cap == src) fprintf(stderr, "Failed to create capture: %s\n", capturePath);
+        src = cap;
+    }
+    return src;
+}
@@ -0,0 +1,206 @@
+// ============================================================
+// nso_scan: base pointer search on a dumped main NSO
+// ============================================================
+//
+//   nso_scan <main.nso> [--sig "<hex ?? ...>" [--adrp <n>]] [--dump <file>] [--top <n>]
+//
+// Runs the same searches as the console's auto-detection on an NSO
+// dumped from the game: decompresses .text, scans it for ADRP pairs
+// (or the given signature) into .data/.bss and prints the ranked
+// candidate base pointers. With --dump (a memory dump of the running
+// game, see sslm-host --save-dump) each candidate is also validated
+// by walking the pointer chain. The game profile is loaded like the
+// app does, so a profile.txt in the working directory applies.
+
+#include "memsource.h"
+#include "profile.h"
+#include "sigscan.h"
+#include "spawners.h"
+#include "stash.h"
+#include "timing.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct NsoSegment {
+    u32 fileOffset;
+    u32 memoryOffset;
+    u32 size;
+};
+
+struct NsoHeader {
+    char       magic[4];        // "NSO0"
+    u32        version;
+    u32        reserved;
+    u32        flags;           // bit 0-2: text/ro/data compressed
+    NsoSegment text;
+    u32        moduleNameOffset;
+    NsoSegment ro;
+    u32        moduleNameSize;
+    NsoSegment data;
+    u32        bssSize;
+    u8         moduleId[0x20];
+    u32        textFileSize;
+    u32        roFileSize;
+    u32        dataFileSize;
+    u8         padding[0x100 - 0x6C];
+};
+static_assert(sizeof(NsoHeader) == 0x100, "NsoHeader layout");
+
+// LZ4 block format (NSO segments are raw blocks, no frame header)
+static bool lz4Decompress(const u8* src, size_t srcLen, u8* dst, size_t dstLen) {
+    size_t ip = 0, op = 0;
+    while (ip < srcLen) {
+        u8 token = src[ip++];
+        size_t lit = token >> 4;
+        if (lit == 15) {
+            u8 b;
+            do { if (ip >= srcLen) return false; b = src[ip++]; lit += b; } while (b == 255);
+        }
+        if (ip + lit > srcLen || op + lit > dstLen) return false;
+        memcpy(dst + op, src + ip, lit);
+        ip += lit;
+        op += lit;
+        if (ip >= srcLen) break;            // last sequence has no match
+
+        if (ip + 2 > srcLen) return false;
+        size_t offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        size_t len = (token & 15) + 4;
+        if ((token & 15) == 15) {
+            u8 b;
+            do { if (ip >= srcLen) return false; b = src[ip++]; len += b; } while (b == 255);
+        }
+        if (offset == 0 || offset > op || op + len > dstLen) return false;
+        for (size_t i = 0; i < len; i++, op++) dst[op] = dst[op - offset];   // may overlap
+    }
+    return op == dstLen;
+}
+
+static bool loadSegment(const std::vector<u8>& file, const NsoSegment& seg, u32 fileSize,
+                        bool compressed, std::vector<u8>& out) {
+    if ((size_t)seg.fileOffset + fileSize > file.size()) return false;
+    out.resize(seg.size);
+    if (!compressed) {
+        if (fileSize < seg.size) return false;
+        memcpy(out.data(), &file[seg.fileOffset], seg.size);
+        return true;
+    }
+    return lz4Decompress(&file[seg.fileOffset], fileSize, out.data(), out.size());
+}
+
+static bool readFile(const char* path, std::vector<u8>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    out.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(out.data(), 1, out.size(), f) == out.size();
+    fclose(f);
+    return ok;
+}
+
+static void loadSpawners() {
+    for (int m = 0; m < (int)g_profile.maps.size(); m++) {
+        std::vector<u8> buf;
+        if (readFile(g_profile.maps[m].spawners.c_str(), buf))
+            parseSpawnerFile(std::string(buf.begin(), buf.end()), m);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* nsoPath = nullptr;
+    const char* dumpPath = nullptr;
+    ScanOptions opt;
+    int top = 20;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--sig") && i + 1 < argc)       opt.signature = argv[++i];
+        else if (!strcmp(argv[i], "--adrp") && i + 1 < argc) opt.adrpOffset = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--dump") && i + 1 < argc) dumpPath = argv[++i];
+        else if (!strcmp(argv[i], "--top") && i + 1 < argc)  top = atoi(argv[++i]);
+        else nsoPath = argv[i];
+    }
+    if (!nsoPath) {
+        fprintf(stderr, "usage: %s <main.nso> [--sig \"<hex ?? ...>\" [--adrp n]] [--dump file] [--top n]\n", argv[0]);
+        return 2;
+    }
+    if (const char* err = profileError()) fprintf(stderr, "%s, using %s\n", err, g_profile.source.c_str());
+
+    std::vector<u8> file;
+    if (!readFile(nsoPath, file) || file.size() < sizeof(NsoHeader)) {
+        fprintf(stderr, "Can't read %s\n", nsoPath);
+        return 1;
+    }
+    NsoHeader hdr;
+    memcpy(&hdr, file.data(), sizeof(hdr));
+    if (memcmp(hdr.magic, "NSO0", 4) != 0) {
+        fprintf(stderr, "%s is not an NSO\n", nsoPath);
+        return 1;
+    }
+    std::vector<u8> text;
+    if (!loadSegment(file, hdr.text, hdr.textFileSize, hdr.flags & 1, text)) {
+        fprintf(stderr, "Bad .text segment\n");
+        return 1;
+    }
+    printf("Build ID %02X%02X%02X%02X%02X%02X%02X%02X, .text %u bytes\n",
+           hdr.moduleId[0], hdr.moduleId[1], hdr.moduleId[2], hdr.moduleId[3],
+           hdr.moduleId[4], hdr.moduleId[5], hdr.moduleId[6], hdr.moduleId[7], hdr.text.size);
+
+    // Addresses are NSO-relative: the NSO is "loaded" at 0
+    const u64 dataLo = hdr.data.memoryOffset;
+    const u64 dataHi = (u64)hdr.data.memoryOffset + hdr.data.size + hdr.bssSize;
+    std::vector<u64> cands;
+    u64 t0 = nowNs();
+    if (!opt.signature.empty()) {
+        Signature sig;
+        if (!parseSignature(opt.signature.c_str(), sig)) {
+            fprintf(stderr, "Bad signature\n");
+            return 1;
+        }
+        std::vector<size_t> hits;
+        findSignature(text.data(), text.size(), sig, hits);
+        printf("%zu signature hits\n", hits.size());
+        for (size_t h : hits) {
+            size_t at = h + opt.adrpOffset;
+            if (at + 8 > text.size()) continue;
+            u32 w0, w1;
+            memcpy(&w0, &text[at], 4);
+            memcpy(&w1, &text[at + 4], 4);
+            u64 t;
+            if (decodeAdrpPair(hdr.text.memoryOffset + at, w0, w1, &t) && t >= dataLo && t < dataHi)
+                cands.push_back(t);
+        }
+    } else {
+        scanPointerLoads(text.data(), text.size(), hdr.text.memoryOffset, dataLo, dataHi, cands);
+    }
+    size_t loads = cands.size();
+    rankCandidates(cands);
+    double ms = (nowNs() - t0) / 1e6;
+    printf("%zu pointer loads, %zu distinct targets in .data/.bss, %.1f ms (%.0f MB/s)\n\n",
+           loads, cands.size(), ms, text.size() / 1e6 / (ms / 1e3));
+
+    MemorySource* mem = nullptr;
+    DmntCheatProcessMetadata meta = {};
+    if (dumpPath) {
+        char a0[] = "nso_scan", a1[] = "--dump";
+        char* args[] = {a0, a1, (char*)dumpPath};
+        mem = createMemorySource(3, args);
+        mem->getMetadata(&meta);
+        loadSpawners();
+    }
+
+    int shown = 0;
+    for (u64 off : cands) {
+        if (shown >= top) break;
+        bool valid = mem && checkBasePointer(*mem, meta, off) == BaseCheck::Valid;
+        if (mem && !valid) continue;
+        printf("  basePointer 0x%llX%s\n", (unsigned long long)off, valid ? "  (validated)" : "");
+        shown++;
+    }
+    if (mem && !shown) printf("  no candidate validated against %s\n", dumpPath);
+    delete mem;
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <switch.h>
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// ============================================================
+// pl (shared font)
+// ============================================================
+//
+// The console's shared font is replaced by a TTF from disk:
+// $SSLM_FONT if set, otherwise DejaVu Sans.
+
+static std::vector<u8> g_fontFile;
+
+Result plInitialize(PlServiceType) { return 0; }
+void   plExit(void) { g_fontFile.clear(); }
+
+Result plGetSharedFontByType(PlFontData* font, PlSharedFontType) {
+    if (g_fontFile.empty()) {
+        const char* path = getenv("SSLM_FONT");
+        if (!path) path = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+        FILE* f = fopen(path, "rb");
+        if (!f) {
+            fprintf(stderr, "Font not found: %s (set SSLM_FONT)\n", path);
+            return 1;
+        }
+        fseek(f, 0, SEEK_END);
+        long sz = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        g_fontFile.resize(sz > 0 ? sz : 0);
+        size_t got = fread(g_fontFile.data(), 1, g_fontFile.size(), f);
+        fclose(f);
+        if (got != g_fontFile.size() || g_fontFile.empty()) { g_fontFile.clear(); return 1; }
+    }
+    font->type    = 0;
+    font->offset  = 0;
+    font->size    = (u32)g_fontFile.size();
+    font->address = g_fontFile.data();
+    return 0;
+}
+
+// ============================================================
+// applet / pad (keyboard)
+// ============================================================
+//
+//   Enter/A = A      Backspace/B = B    X, Y, L, R as labelled
+//   Arrows  = D-Pad  Q/E = ZL/ZR        - = Minus   Esc/+ = Plus
+//   Keypad 8/4/6/2 = left stick, 5 = click   left mouse button = touch
+
+static bool g_quit = false;
+
+bool appletMainLoop(void) { return !g_quit; }
+
+void padConfigureInput(u32, u32) {}
+
+void padInitializeDefault(PadState* pad) {
+    pad->buttons_cur = 0;
+    pad->buttons_old = 0;
+    pad->sticks[0] = pad->sticks[1] = {0, 0};
+}
+
+static u64 keyToButton(SDL_Keycode key) {
+    switch (key) {
+        case SDLK_RETURN: case SDLK_a:      return HidNpadButton_A;
+        case SDLK_BACKSPACE: case SDLK_b:   return HidNpadButton_B;
+        case SDLK_x:                        return HidNpadButton_X;
+        case SDLK_y:                        return HidNpadButton_Y;
+        case SDLK_l:                        return HidNpadButton_L;
+        case SDLK_r:                        return HidNpadButton_R;
+        case SDLK_KP_5:                     return HidNpadButton_StickL;
+        case SDLK_KP_0: case SDLK_TAB:      return HidNpadButton_StickR;
+        case SDLK_q:                        return HidNpadButton_ZL;
+        case SDLK_e:                        return HidNpadButton_ZR;
+        case SDLK_MINUS: case SDLK_KP_MINUS: return HidNpadButton_Minus;
+        case SDLK_ESCAPE: case SDLK_PLUS: case SDLK_KP_PLUS: case SDLK_EQUALS:
+                                            return HidNpadButton_Plus;
+        case SDLK_LEFT:                     return HidNpadButton_Left;
+        case SDLK_UP:                       return HidNpadButton_Up;
+        case SDLK_RIGHT:                    return HidNpadButton_Right;
+        case SDLK_DOWN:                     return HidNpadButton_Down;
+        default:                            return 0;
+    }
+}
+
+static bool g_touching = false;
+static int  g_touchX = 0, g_touchY = 0;
+static int  g_stickKeys = 0;   // bit 0-3: up, down, left, right held
+static u64  g_keyboard[4] = {};   // HidKeyboardKey bits held
+
+static int keyToKeyboard(SDL_Keycode key) {
+    if (key >= 'a' && key <= 'z') return HidKeyboardKey_A + (key - 'a');
+    if (key >= '1' && key <= '9') return HidKeyboardKey_D1 + (key - '1');
+    if (key == '0')               return HidKeyboardKey_D0;
+    if (key == ' ')               return HidKeyboardKey_Space;
+    if (key == SDLK_BACKSPACE)    return HidKeyboardKey_Backspace;
+    return 0;
+}
+
+static int keyToStick(SDL_Keycode key) {
+    switch (key) {
+        case SDLK_KP_8: return 1;
+        case SDLK_KP_2: return 2;
+        case SDLK_KP_4: return 4;
+        case SDLK_KP_6: return 8;
+        default:        return 0;
+    }
+}
+
+void padUpdate(PadState* pad) {
+    pad->buttons_old = pad->buttons_cur;
+    SDL_Event ev;
+    while (SDL_PollEvent(&ev)) {
+        if (ev.type == SDL_QUIT) g_quit = true;
+        else if (ev.type == SDL_KEYDOWN) {
+            pad->buttons_cur |= keyToButton(ev.key.keysym.sym);
+            g_stickKeys |= keyToStick(ev.key.keysym.sym);
+            if (int k = keyToKeyboard(ev.key.keysym.sym)) g_keyboard[k / 64] |= 1ULL << (k % 64);
+        } else if (ev.type == SDL_KEYUP) {
+            pad->buttons_cur &= ~keyToButton(ev.key.keysym.sym);
+            g_stickKeys &= ~keyToStick(ev.key.keysym.sym);
+            if (int k = keyToKeyboard(ev.key.keysym.sym)) g_keyboard[k / 64] &= ~(1ULL << (k % 64));
+        } else if (ev.type == SDL_MOUSEBUTTONDOWN && ev.button.button == SDL_BUTTON_LEFT) {
+            g_touching = true;
+            g_touchX = ev.button.x;
+            g_touchY = ev.button.y;
+        } else if (ev.type == SDL_MOUSEBUTTONUP && ev.button.button == SDL_BUTTON_LEFT) {
+            g_touching = false;
+        } else if (ev.type == SDL_MOUSEMOTION && g_touching) {
+            g_touchX = ev.motion.x;
+            g_touchY = ev.motion.y;
+        }
+    }
+    HidAnalogStickState& st = pad->sticks[0];
+    st.y = (g_stickKeys & 1 ? JOYSTICK_MAX : 0) - (g_stickKeys & 2 ? JOYSTICK_MAX : 0);
+    st.x = (g_stickKeys & 8 ? JOYSTICK_MAX : 0) - (g_stickKeys & 4 ? JOYSTICK_MAX : 0);
+}
+
+// ============================================================
+// hid touch screen (mouse)
+// ============================================================
+
+void hidInitializeTouchScreen(void) {}
+
+size_t hidGetTouchScreenStates(HidTouchScreenState* states, size_t count) {
+    if (count == 0) return 0;
+    *states = {};
+    if (g_touching) {
+        states->count = 1;
+        states->touches[0].x = (u32)std::max(g_touchX, 0);
+        states->touches[0].y = (u32)std::max(g_touchY, 0);
+    }
+    return 1;
+}
+
+// ============================================================
+// hid keyboard
+// ============================================================
+
+void hidInitializeKeyboard(void) {}
+
+size_t hidGetKeyboardStates(HidKeyboardState* states, size_t count) {
+    if (count == 0) return 0;
+    *states = {};
+    for (int i = 0; i < 4; i++) states->keys[i] = g_keyboard[i];
+    return 1;
+}
+
+// ============================================================
+// swkbd (the host keyboard types directly instead)
+// ============================================================
+
+Result swkbdCreate(SwkbdConfig*, s32)                        { return 1; }
+void   swkbdClose(SwkbdConfig*)                              {}
+void   swkbdConfigMakePresetDefault(SwkbdConfig*)            {}
+void   swkbdConfigSetGuideText(SwkbdConfig*, const char*)    {}
+void   swkbdConfigSetInitialText(SwkbdConfig*, const char*)  {}
+Result swkbdShow(SwkbdConfig*, char*, size_t)                { return 1; }
@@ -0,0 +1,28 @@
+#include "synth.h"
+#include "pkx.h"
+#include "spawners.h"
+#include "stash.h"
+
+#include <cstring>
+
+void synthesizeStashBlock(u8* stash, int count, std::mt19937& rng) {
+    memset(stash, 0, g_profile.stashSize);
+    for (int i = 0; i < g_profile.slots; i++) {
+        u8* e = &stash[i * g_profile.entrySize];
+        if (i >= count || g_spawners.empty()) {
+            memcpy(e, &TERMINATOR_HASH, sizeof(u64));
+            continue;
+        }
+        u64 hash = g_spawners[rng() % g_spawners.size()].hash;
+        memcpy(e, &hash, sizeof(u64));
+
+        u8 pa9[PA9_SIZE] = {};
+        u32 ec = rng();
+        u16 species = getInternal9((u16)(1 + rng() % 1025));
+        memcpy(pa9, &ec, sizeof(u32));
+        memcpy(&pa9[PA9_SPECIES_OFF], &species, sizeof(u16));
+        pa9UpdateChecksum(pa9);
+        encryptPA9(pa9, PA9_SIZE);
+        memcpy(e + g_profile.pa9Offset, pa9, PA9_SIZE);
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <switch.h>
+
+#include <random>
+
+// Fills a g_profile.stashSize block with `count` encrypted PA9 entries
+// whose hashes are drawn from g_spawners; remaining slots hold the
+// terminator hash.
+void synthesizeStashBlock(u8* stash, int count, std::mt19937& rng);
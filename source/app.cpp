@@ -0,0 +1,1511 @@
+#include "app.h"
+#include "config.h"
+#include "digest.h"
+#include "memsource.h"
+#include "paths.h"
+#include "pkx.h"
+#include "cluster.h"
+#include "filter.h"
+#include "heatmap.h"
+#include "labels.h"
+#include "namehash.h"
+#include "player.h"
+#include "regions.h"
+#include "route.h"
+#include "search.h"
+#include "spatial.h"
+#include "species.h"
+#include "timing.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <unordered_map>
+
+// ============================================================
+// Global State
+// ============================================================
+
+SDL_Window*   g_window   = nullptr;
+SDL_Renderer* g_renderer = nullptr;
+TTF_Font*     g_fontLg   = nullptr;   // 26
+TTF_Font*     g_fontMd   = nullptr;   // 20
+TTF_Font*     g_fontSm   = nullptr;   // 15
+static SDL_Texture*  g_mapTex[MAP_MAX] = {};
+static int           g_mapW[MAP_MAX]   = {};
+static int           g_mapH[MAP_MAX]   = {};
+static SDL_Texture*  g_heatTex[MAP_MAX] = {};   // uploaded on first use, dropped by loadData()
+
+std::vector<ShinyEntry>   g_entries;
+
+int  g_selIdx     = 0;
+int  g_scrollOff  = 0;
+const SpawnerEntry* g_selSpawner = nullptr;
+std::string g_statusMsg = "Press A to read game memory";
+std::string g_gameVersion;
+std::string g_detectedBid;
+bool g_showAbout  = false;
+
+MemorySource* g_mem = nullptr;
+StashReader   g_reader;
+bool g_liveMode        = false;
+u64  g_entriesVersion  = 0;
+bool g_cursorMode      = false;
+bool g_showLabels      = false;
+bool g_showHeatmap     = false;
+bool g_showRegions     = false;
+bool g_showRoute       = false;
+bool g_browseMode      = false;
+static u64 g_nextPollNs = 0;
+
+// Map filter (filter.h)
+static int         g_filterPreset  = FILTER_OFF;
+static u64         g_filterVersion = 0;       // bumped whenever g_filter or the index changes
+static SpawnerBits g_filterBits;              // g_filter over g_filterMap's spawners
+static int         g_filterMap     = -1;
+static u64         g_filterBuilt   = ~0ULL;   // g_filterVersion of g_filterBits
+static u64         g_filterEntries = ~0ULL;   // g_entriesVersion of g_filterBits
+static u32         g_filterCount   = 0;
+static u64         g_filterNs      = 0;       // time the last evaluation took
+static bool      g_havePlayer = false;   // g_playerPos is on the displayed map this frame
+static PlayerPos g_playerPos;
+static FILE* g_pauseLog = nullptr;
+static u64   g_loggedPauses = 0;
+
+// Free cursor, in texture pixels of g_cursorMap
+static int   g_cursorMap  = 0;
+static float g_cursorTexX = 0, g_cursorTexZ = 0;
+static int   g_cursorHit  = -1;   // nearest spawner (index into g_spawners)
+static float g_cursorDist = 0;
+
+static std::unordered_map<u16, SDL_Texture*> g_spriteCache;
+static constexpr int SPRITE_SIZE = 40;  // display size in the list
+
+struct TextTex { SDL_Texture* tex; int w, h; };
+static std::unordered_map<u32, TextTex>         g_countCache;
+static std::unordered_map<const char*, TextTex> g_labelCache;   // by interned location
+
+static TextTex makeTextTex(TTF_Font* font, const char* text, SDL_Color col) {
+    TextTex tt = {nullptr, 0, 0};
+    if (SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, col)) {
+        tt = {SDL_CreateTextureFromSurface(g_renderer, surf), surf->w, surf->h};
+        SDL_FreeSurface(surf);
+    }
+    return tt;
+}
+
+static SDL_Texture* getSpriteTex(u16 nationalDex) {
+    auto it = g_spriteCache.find(nationalDex);
+    if (it != g_spriteCache.end()) return it->second;
+    char path[64];
+    snprintf(path, sizeof(path), ROMFS_ROOT "sprites/%03u.png", nationalDex);
+    SDL_Surface* surf = IMG_Load(path);
+    SDL_Texture* tex = nullptr;
+    if (surf) {
+        tex = SDL_CreateTextureFromSurface(g_renderer, surf);
+        SDL_FreeSurface(surf);
+    }
+    g_spriteCache[nationalDex] = tex;  // cache nullptr too to avoid retrying
+    return tex;
+}
+
+// ============================================================
+// Species Names
+// ============================================================
+
+static const char* getSpeciesName(u16 ndex) {
+    if (const char* name = speciesName(ndex)) return name;
+    static char buf[32];
+    snprintf(buf, sizeof(buf), "Species #%u", ndex);
+    return buf;
+}
+
+// ============================================================
+// Drawing Helpers
+// ============================================================
+
+static void drawText(TTF_Font* font, const char* text, int x, int y, SDL_Color col) {
+    if (!text || !text[0]) return;
+    SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, col);
+    if (!surf) return;
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(g_renderer, surf);
+    SDL_Rect dst = {x, y, surf->w, surf->h};
+    SDL_RenderCopy(g_renderer, tex, nullptr, &dst);
+    SDL_DestroyTexture(tex);
+    SDL_FreeSurface(surf);
+}
+
+static void drawTextRight(TTF_Font* font, const char* text, int rightX, int y, SDL_Color col) {
+    if (!text || !text[0]) return;
+    SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, col);
+    if (!surf) return;
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(g_renderer, surf);
+    SDL_Rect dst = {rightX - surf->w, y, surf->w, surf->h};
+    SDL_RenderCopy(g_renderer, tex, nullptr, &dst);
+    SDL_DestroyTexture(tex);
+    SDL_FreeSurface(surf);
+}
+
+static void fillCircle(int cx, int cy, int r) {
+    for (int dy = -r; dy <= r; dy++) {
+        int dx = (int)sqrtf((float)(r * r - dy * dy));
+        SDL_RenderDrawLine(g_renderer, cx - dx, cy + dy, cx + dx, cy + dy);
+    }
+}
+
+static void drawCircleOutline(int cx, int cy, int r) {
+    int x = r, y = 0, err = 1 - r;
+    while (x >= y) {
+        SDL_RenderDrawPoint(g_renderer, cx+x, cy+y); SDL_RenderDrawPoint(g_renderer, cx-x, cy+y);
+        SDL_RenderDrawPoint(g_renderer, cx+x, cy-y); SDL_RenderDrawPoint(g_renderer, cx-x, cy-y);
+        SDL_RenderDrawPoint(g_renderer, cx+y, cy+x); SDL_RenderDrawPoint(g_renderer, cx-y, cy+x);
+        SDL_RenderDrawPoint(g_renderer, cx+y, cy-x); SDL_RenderDrawPoint(g_renderer, cx-y, cy-x);
+        y++;
+        if (err < 0) err += 2*y+1;
+        else { x--; err += 2*(y-x)+1; }
+    }
+}
+
+static void drawRect(int x, int y, int w, int h, SDL_Color c) {
+    SDL_SetRenderDrawColor(g_renderer, c.r, c.g, c.b, c.a);
+    SDL_Rect r = {x, y, w, h};
+    SDL_RenderFillRect(g_renderer, &r);
+}
+
+static void drawBorder(int x, int y, int w, int h, SDL_Color c) {
+    SDL_SetRenderDrawColor(g_renderer, c.r, c.g, c.b, c.a);
+    SDL_Rect r = {x, y, w, h};
+    SDL_RenderDrawRect(g_renderer, &r);
+}
+
+// ============================================================
+// File I/O
+// ============================================================
+
+static std::string readTextFile(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return "";
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (sz <= 0) { fclose(f); return ""; }
+    std::string s(sz, '\0');
+    fread(&s[0], 1, sz, f);
+    fclose(f);
+    return s;
+}
+
+// ============================================================
+// Data Loading
+// ============================================================
+
+// One structure per profile map over g_spawners; slots past the
+// profile's maps are cleared
+template <typename T, typename F>
+static void buildPerMap(T (&perMap)[MAP_MAX], F&& build) {
+    for (int m = 0; m < MAP_MAX; m++) {
+        if (m < (int)g_profile.maps.size()) build(perMap[m], m, g_profile.maps[m].transform);
+        else                                perMap[m].clear();
+    }
+}
+
+void loadData() {
+    // Spawners
+    const int mapCount = (int)g_profile.maps.size();
+    g_nameTemplates.clear();
+    for (int i = 0; i < mapCount; i++) {
+        std::string content = readTextFile(g_profile.maps[i].spawners.c_str());
+        if (!content.empty()) parseSpawnerFile(content, i, &g_nameTemplates);
+    }
+    g_nameTemplates.finish();
+    g_spawnerNames.load();
+    for (auto& tex : g_heatTex) {
+        if (tex) SDL_DestroyTexture(tex);
+        tex = nullptr;
+    }
+    buildPerMap(g_spatial,     [](SpatialGrid& g, int m, const MapTransform&) { g.build(g_spawners, m); });
+    buildPerMap(g_clusters,    [](ClusterPyramid& p, int m, const MapTransform& tr) { p.build(g_spawners, m, tr); });
+    buildPerMap(g_labels,      [](LabelLayer& l, int m, const MapTransform& tr) { l.build(g_spawners, m, tr); });
+    buildPerMap(g_filterIndex, [](FilterIndex& f, int m, const MapTransform& tr) { f.build(g_spawners, m, tr); });
+    buildSpawnerSearch();
+    g_filterVersion++;
+    startRegionBuild();
+    startHeatmapBuild();
+    for (int i = 0; i < mapCount; i++)
+        for (LabelAnchor& a : g_labels[i].anchors())
+            TTF_SizeUTF8(g_fontSm, a.name, &a.w, &a.h);
+
+    // Map textures
+    for (int i = 0; i < mapCount; i++) {
+        SDL_Surface* surf = IMG_Load(g_profile.maps[i].image.c_str());
+        if (!surf) {
+            g_statusMsg = std::string("IMG_Load failed: ") + IMG_GetError();
+            continue;
+        }
+        g_mapTex[i] = SDL_CreateTextureFromSurface(g_renderer, surf);
+        g_mapW[i] = surf->w;
+        g_mapH[i] = surf->h;
+        SDL_FreeSurface(surf);
+        if (!g_mapTex[i])
+            g_statusMsg = std::string("Texture failed: ") + SDL_GetError();
+    }
+}
+
+// ============================================================
+// Memory Reading
+// ============================================================
+
+static void focusSelection();
+static void applyMapFilter();
+
+void updateSelection() {
+    g_selSpawner = nullptr;
+    if (g_selIdx >= 0 && g_selIdx < (int)g_entries.size())
+        g_selSpawner = findSpawner(g_entries[g_selIdx].hash);
+    focusSelection();
+    if (g_filterPreset == FILTER_LOCATION) applyMapFilter();
+}
+
+// Entries outside the spawner files are named in the background
+static void requestSpawnerNames() {
+    static std::vector<u64> unknown;
+    unknown.clear();
+    for (const ShinyEntry& e : g_entries)
+        if (!findSpawner(e.hash)) unknown.push_back(e.hash);
+    if (!unknown.empty()) g_spawnerNames.request(unknown);
+}
+
+static void setLoadedStatus() {
+    if (g_entries.empty())
+        g_statusMsg = "Shiny stash is empty";
+    else
+        g_statusMsg = std::to_string(g_entries.size()) + " shiny entries loaded (" +
+                      (g_gameVersion == "auto" ? std::string("auto-detected build") : "v" + g_gameVersion) + ")";
+    int bad = 0;
+    for (auto& e : g_entries) bad += !e.checksumOk;
+    if (bad)
+        g_statusMsg += ", " + std::to_string(bad) + " unreadable";
+    if (g_reader.pauseRefused())
+        g_statusMsg += " - pause over budget, verified reads";
+}
+
+// One line per paused snapshot in DATA_ROOT "pause.log"
+static void logPause() {
+    const StashStats& st = g_reader.stats();
+    if (st.pauses == g_loggedPauses) return;
+    g_loggedPauses = st.pauses;
+
+    if (!g_pauseLog) {
+        makeDirs(DATA_ROOT);
+        g_pauseLog = fopen(DATA_ROOT "pause.log", "a");
+        if (!g_pauseLog) return;
+    }
+    time_t now = time(nullptr);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    u64 us = st.lastPauseNs / 1000;
+    fprintf(g_pauseLog, "%s  v%s  pause %llu us  budget %d us%s\n", stamp, g_gameVersion.c_str(),
+            (unsigned long long)us, g_config.snapshot.pauseBudgetUs,
+            us > (u64)g_config.snapshot.pauseBudgetUs ? "  OVER" : "");
+}
+
+// The player tracker shares the session, so it lives inside attach/detach.
+// `retryScan`: the user asked for this read, so a failed scan runs again.
+static bool attachReader(bool retryScan = false) {
+    g_player.stop();
+    bool ok = g_reader.attach(*g_mem, retryScan);
+    g_loggedPauses = 0;
+    g_detectedBid = g_reader.buildId();
+    if (ok)
+        g_gameVersion = g_reader.version();
+    else if (!g_detectedBid.empty())
+        g_gameVersion.clear();
+    if (!ok) g_statusMsg = g_reader.status();
+    if (ok && g_liveMode) g_player.start(*g_mem, g_reader.metadata(), g_config.playerHz);
+    return ok;
+}
+
+// A one-shot read whose verification continues on a later frame
+static bool g_readPending = false;
+
+static void detachReader() {
+    g_player.stop();
+    g_reader.detach();
+    g_readPending = false;
+}
+
+static void finishRead(RefreshResult res) {
+    logPause();
+    g_readPending = res == RefreshResult::Pending;
+    if (g_readPending) return;   // pollStash() makes the next attempt
+
+    if (res == RefreshResult::Error)
+        g_statusMsg = g_reader.status();
+    else {
+        setLoadedStatus();
+        updateSelection();
+    }
+    g_entriesVersion++;
+    requestSpawnerNames();
+
+    // Live mode keeps the session open for polling
+    if (!g_liveMode) detachReader();
+}
+
+void readShinyStash() {
+    g_entries.clear();
+    g_selIdx = 0;
+    g_scrollOff = 0;
+    g_selSpawner = nullptr;
+    g_detectedBid.clear();
+
+    if (!attachReader(true)) return;
+
+    g_reader.invalidate();
+    finishRead(g_reader.refresh(g_entries));
+}
+
+void setLiveMode(bool on) {
+    g_liveMode = on;
+    g_nextPollNs = 0;
+    if (!on) detachReader();
+}
+
+void pollStash() {
+    // An unknown build is scanned on a worker; the read that started the
+    // scan completes once it is done
+    if (g_reader.scanning()) {
+        if (g_reader.scanFinished()) readShinyStash();
+        return;
+    }
+    if (g_readPending) {
+        if (nowNs() >= g_reader.retryAtNs()) finishRead(g_reader.refresh(g_entries));
+        return;
+    }
+    if (!g_liveMode) return;
+    u64 now = nowNs();
+    if (now < g_nextPollNs) return;
+    g_nextPollNs = now + (u64)g_config.liveIntervalMs * 1000000ULL;
+
+    if (!g_reader.attached() && !attachReader()) return;
+
+    // Keep the selection on the same stash entry across changes
+    u64 selHash = (g_selIdx >= 0 && g_selIdx < (int)g_entries.size()) ? g_entries[g_selIdx].hash : 0;
+
+    RefreshResult res = g_reader.refresh(g_entries);
+    logPause();
+    switch (res) {
+        case RefreshResult::Unchanged:
+            return;
+        case RefreshResult::Pending:
+            g_nextPollNs = g_reader.retryAtNs();   // re-read on a later frame, not after a full interval
+            return;
+        case RefreshResult::Error:
+            g_statusMsg = g_reader.status();
+            detachReader();   // reattach on the next poll (game restarted, etc.)
+            return;
+        case RefreshResult::Changed:
+            break;
+    }
+
+    g_selIdx = 0;
+    for (int i = 0; i < (int)g_entries.size(); i++)
+        if (g_entries[i].hash == selHash) { g_selIdx = i; break; }
+    updateSelection();
+    setLoadedStatus();
+    g_entriesVersion++;
+    requestSpawnerNames();
+}
+
+// ============================================================
+// Map View
+// ============================================================
+
+static constexpr int   CURSOR_DEADZONE = JOYSTICK_MAX * 15 / 100;
+static constexpr float CURSOR_SPEED    = 6.0f;    // screen px per frame at full tilt
+static constexpr float CLUSTER_CELL_PX = 24.0f;   // min on-screen cluster cell
+
+// Visible part of a map: the image is aspect-fit into `dst` and shows a
+// 1/g_mapZoom window of the texture centred on g_viewTexX/Z.
+struct MapView {
+    int      mapIdx;
+    SDL_Rect dst;
+    double   srcX, srcZ;   // texture pixel at dst's top-left
+    double   scale;        // screen px per texture px
+    double   texW, texH;   // visible window
+
+    int screenX(double tx) const { return dst.x + (int)((tx - srcX) * scale); }
+    int screenY(double tz) const { return dst.y + (int)((tz - srcZ) * scale); }
+    bool contains(int px, int py) const {
+        return px >= dst.x && px < dst.x + dst.w && py >= dst.y && py < dst.y + dst.h;
+    }
+};
+
+static int   g_viewMap  = -1;
+static float g_viewTexX = 0, g_viewTexZ = 0;
+int g_mapZoom = 1;
+
+static bool mapView(int mapIdx, MapView& v) {
+    if (mapIdx < 0 || !g_mapTex[mapIdx]) return false;
+    const MapTransform& tr = g_profile.maps[mapIdx].transform;
+    if (mapIdx != g_viewMap) {
+        g_viewMap  = mapIdx;
+        g_viewTexX = (float)tr.texW / 2;
+        g_viewTexZ = (float)tr.texH / 2;
+    }
+    int tw = g_mapW[mapIdx], th = g_mapH[mapIdx];
+    float sc = std::min((float)(MAP_AREA_W - 4) / tw, (float)(MAP_AREA_H - 4) / th);
+    v.mapIdx = mapIdx;
+    v.dst.w = (int)(tw * sc);
+    v.dst.h = (int)(th * sc);
+    v.dst.x = MAP_AREA_X + (MAP_AREA_W - v.dst.w) / 2;
+    v.dst.y = MAP_AREA_Y + (MAP_AREA_H - v.dst.h) / 2;
+    v.texW  = tr.texW / g_mapZoom;
+    v.texH  = tr.texH / g_mapZoom;
+    v.srcX  = std::clamp(g_viewTexX - v.texW / 2, 0.0, tr.texW - v.texW);
+    v.srcZ  = std::clamp(g_viewTexZ - v.texH / 2, 0.0, tr.texH - v.texH);
+    v.scale = v.dst.w / v.texW;
+    return true;
+}
+
+// Map shown in the map panel, or -1
+static int displayedMap() {
+    if (g_cursorMode) return g_cursorMap;
+    return g_selSpawner ? g_selSpawner->mapIdx : -1;
+}
+
+// Pans so (texX, texZ) sits inside the middle `keep` fraction of the view
+static void keepInView(int mapIdx, float texX, float texZ, float keep) {
+    MapView v;
+    if (!mapView(mapIdx, v)) return;
+    float hx = (float)v.texW * keep / 2, hz = (float)v.texH * keep / 2;
+    float cx = (float)(v.srcX + v.texW / 2), cz = (float)(v.srcZ + v.texH / 2);
+    g_viewTexX = std::clamp(cx, texX - hx, texX + hx);
+    g_viewTexZ = std::clamp(cz, texZ - hz, texZ + hz);
+}
+
+static void focusSelection() {
+    if (!g_selSpawner || g_cursorMode) return;
+    const MapTransform& tr = g_profile.maps[g_selSpawner->mapIdx].transform;
+    keepInView(g_selSpawner->mapIdx, (float)tr.convertX(g_selSpawner->x),
+               (float)tr.convertZ(g_selSpawner->z), 0.0f);
+}
+
+void zoomMap(int dir) {
+    int zoom = dir > 0 ? g_mapZoom * 2 : g_mapZoom / 2;
+    g_mapZoom = std::clamp(zoom, 1, MAP_ZOOM_MAX);
+    if (g_cursorMode) keepInView(g_cursorMap, g_cursorTexX, g_cursorTexZ, 0.0f);
+    else              focusSelection();
+}
+
+// ============================================================
+// Cursor
+// ============================================================
+
+static void updateCursorHit() {
+    const MapTransform& tr = g_profile.maps[g_cursorMap].transform;
+    float wx = (float)tr.invertX(g_cursorTexX);
+    float wz = (float)tr.invertZ(g_cursorTexZ);
+    g_cursorHit = g_spatial[g_cursorMap].nearest(wx, wz, &g_cursorDist);
+}
+
+static void resetCursor(int mapIdx) {
+    const MapTransform& tr = g_profile.maps[mapIdx].transform;
+    g_cursorMap = mapIdx;
+    g_cursorTexX = (float)tr.texW / 2;
+    g_cursorTexZ = (float)tr.texH / 2;
+    if (g_selSpawner && g_selSpawner->mapIdx == mapIdx) {
+        g_cursorTexX = (float)tr.convertX(g_selSpawner->x);
+        g_cursorTexZ = (float)tr.convertZ(g_selSpawner->z);
+    }
+    keepInView(mapIdx, g_cursorTexX, g_cursorTexZ, 0.8f);
+    updateCursorHit();
+}
+
+void setCursorMode(bool on) {
+    g_cursorMode = on && !g_profile.maps.empty();
+    if (g_cursorMode) resetCursor(g_selSpawner ? g_selSpawner->mapIdx : 0);
+    else              focusSelection();
+}
+
+void cycleCursorMap() {
+    if (g_cursorMode) resetCursor((g_cursorMap + 1) % (int)g_profile.maps.size());
+}
+
+void moveCursor(int stickX, int stickY) {
+    if (!g_cursorMode) return;
+    if (std::abs(stickX) < CURSOR_DEADZONE) stickX = 0;
+    if (std::abs(stickY) < CURSOR_DEADZONE) stickY = 0;
+    if (!stickX && !stickY) return;
+
+    const MapTransform& tr = g_profile.maps[g_cursorMap].transform;
+    MapView v;
+    float texPerPx = mapView(g_cursorMap, v) ? (float)(1.0 / v.scale) : 1.0f;
+    float step = CURSOR_SPEED * texPerPx / JOYSTICK_MAX;
+    g_cursorTexX = std::clamp(g_cursorTexX + stickX * step, 0.0f, (float)tr.texW);
+    g_cursorTexZ = std::clamp(g_cursorTexZ - stickY * step, 0.0f, (float)tr.texH);   // stick up = north
+    keepInView(g_cursorMap, g_cursorTexX, g_cursorTexZ, 0.8f);
+    updateCursorHit();
+}
+
+bool touchMap(int x, int y) {
+    int mapIdx = displayedMap();
+    MapView v;
+    if (!mapView(mapIdx, v) || !v.contains(x, y)) return false;
+
+    if (!g_cursorMode) setCursorMode(true);
+    g_cursorMap = mapIdx;
+    g_cursorTexX = (float)(v.srcX + (x - v.dst.x) / v.scale);
+    g_cursorTexZ = (float)(v.srcZ + (y - v.dst.y) / v.scale);
+    updateCursorHit();
+    return true;
+}
+
+// ============================================================
+// Spawner Browser
+// ============================================================
+
+static constexpr int BROWSE_ROW_H   = 26;
+static constexpr int BROWSE_QUERY_MAX = 32;
+
+static std::string             g_browseQuery;
+static std::vector<BrowserRow> g_browseRows;
+static int g_browseSel    = -1;   // row index of a spawner row, or -1
+static int g_browseScroll = 0;
+static u32 g_browseMatches  = 0;
+static u64 g_browseFilterNs = 0;  // time the last keystroke took to filter
+
+static int browseVisibleRows() {
+    return (SCREEN_H - 30 - (LIST_Y + 76)) / BROWSE_ROW_H;
+}
+
+// Cursor on the selected spawner, centred
+static void focusBrowseRow() {
+    if (g_browseSel < 0) return;
+    const SpawnerEntry& sp = g_spawners[g_search.spawnerAt(g_browseRows[g_browseSel].pos)];
+    const MapTransform& tr = g_profile.maps[sp.mapIdx].transform;
+    g_cursorMode = true;
+    g_cursorMap  = sp.mapIdx;
+    g_cursorTexX = (float)tr.convertX(sp.x);
+    g_cursorTexZ = (float)tr.convertZ(sp.z);
+    keepInView(sp.mapIdx, g_cursorTexX, g_cursorTexZ, 0.0f);
+    updateCursorHit();
+}
+
+// Re-filters for g_browseQuery, keeping the selected spawner when it still matches
+static void refreshBrowse() {
+    u32 selPos = g_browseSel >= 0 ? g_browseRows[g_browseSel].pos : ~0u;
+    u64 t0 = nowNs();
+    const std::vector<u32>& hits = g_search.search(g_browseQuery);
+    g_browseFilterNs = nowNs() - t0;
+    g_browseMatches = (u32)hits.size();
+    g_search.buildRows(hits, g_browseRows);
+
+    g_browseSel = -1;
+    for (int i = 0; i < (int)g_browseRows.size(); i++) {
+        if (g_browseRows[i].kind != BrowserRow::Spawner) continue;
+        if (g_browseSel < 0) g_browseSel = i;
+        if (g_browseRows[i].pos == selPos) { g_browseSel = i; break; }
+    }
+    if (g_browseSel < 0) g_browseScroll = 0;
+    focusBrowseRow();
+}
+
+void setBrowseMode(bool on) {
+    g_browseMode = on && g_search.size() > 0;
+    if (g_browseMode) {
+        refreshBrowse();
+    } else {
+        g_browseRows.clear();
+        g_browseSel = -1;
+        setCursorMode(false);
+    }
+}
+
+void browseMove(int delta) {
+    if (g_browseSel < 0) return;
+    if (delta == 0) return;
+    int step = delta > 0 ? 1 : -1;
+    int sel = g_browseSel;
+    for (int n = std::abs(delta), i = sel + step; n > 0 && i >= 0 && i < (int)g_browseRows.size(); i += step) {
+        if (g_browseRows[i].kind != BrowserRow::Spawner) continue;
+        sel = i;
+        n--;
+    }
+    if (sel == g_browseSel) return;
+    g_browseSel = sel;
+    focusBrowseRow();
+}
+
+void browsePage(int dir) {
+    browseMove(dir * std::max(1, browseVisibleRows() - 1));
+}
+
+void browseType(char c) {
+    if (!g_browseMode || (int)g_browseQuery.size() >= BROWSE_QUERY_MAX) return;
+    g_browseQuery += c;
+    refreshBrowse();
+}
+
+void browseErase() {
+    if (!g_browseMode || g_browseQuery.empty()) return;
+    g_browseQuery.pop_back();
+    refreshBrowse();
+}
+
+void browseKeyboard() {
+    if (!g_browseMode) return;
+    SwkbdConfig kbd;
+    if (R_FAILED(swkbdCreate(&kbd, 0))) {
+        g_statusMsg = "Software keyboard unavailable";
+        return;
+    }
+    swkbdConfigMakePresetDefault(&kbd);
+    swkbdConfigSetGuideText(&kbd, "Location or hash prefix");
+    swkbdConfigSetInitialText(&kbd, g_browseQuery.c_str());
+    char text[BROWSE_QUERY_MAX + 1] = {};
+    Result rc = swkbdShow(&kbd, text, sizeof(text));
+    swkbdClose(&kbd);
+    if (R_FAILED(rc)) return;
+    g_browseQuery = text;
+    refreshBrowse();
+}
+
+// ============================================================
+// Map Filter
+// ============================================================
+
+static void applyMapFilter() {
+    std::string expr;
+    switch (g_filterPreset) {
+        case FILTER_STASH:    expr = "stash"; break;
+        case FILTER_LOCATION: if (g_selSpawner) expr = std::string("loc:\"") + g_selSpawner->location + "\""; break;
+        case FILTER_CUSTOM:   expr = g_config.mapFilter; break;
+    }
+    if (const char* err = g_filter.parse(expr)) {
+        g_statusMsg = std::string("map_filter: ") + err;
+        g_filter.clear();
+    }
+    g_filterVersion++;
+}
+
+void setMapFilter(int preset) {
+    g_filterPreset = std::clamp(preset, 0, FILTER_PRESET_COUNT - 1);
+    applyMapFilter();
+}
+
+void cycleMapFilter() {
+    // Presets with nothing to filter by are skipped
+    int preset = g_filterPreset;
+    do {
+        preset = (preset + 1) % FILTER_PRESET_COUNT;
+    } while ((preset == FILTER_LOCATION && !g_selSpawner) ||
+             (preset == FILTER_CUSTOM && g_config.mapFilter.empty()));
+    setMapFilter(preset);
+}
+
+// Spawners of mapIdx passing the filter, re-evaluated only when the
+// filter, the stash or the map changes; nullptr while no filter is set
+static const SpawnerBits* mapFilterBits(int mapIdx) {
+    if (!g_filter.active()) return nullptr;
+    if (mapIdx != g_filterMap || g_filterBuilt != g_filterVersion || g_filterEntries != g_entriesVersion) {
+        static std::vector<u64> stash;
+        stash.clear();
+        for (const ShinyEntry& e : g_entries) stash.push_back(e.hash);
+        u64 t0 = nowNs();
+        g_filter.evaluate(g_filterIndex[mapIdx], mapIdx, stash, g_filterBits);
+        g_filterNs = nowNs() - t0;
+        g_filterCount   = g_filterBits.count();
+        g_filterMap     = mapIdx;
+        g_filterBuilt   = g_filterVersion;
+        g_filterEntries = g_entriesVersion;
+    }
+    return &g_filterBits;
+}
+
+// ============================================================
+// Rendering
+// ============================================================
+
+// Cluster counts repeat from frame to frame, so their text is kept
+static SDL_Texture* getCountTex(u32 count, int& w, int& h) {
+    auto it = g_countCache.find(count);
+    if (it == g_countCache.end()) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u", count);
+        it = g_countCache.emplace(count, makeTextTex(g_fontSm, buf, COL_WHITE)).first;
+    }
+    w = it->second.w;
+    h = it->second.h;
+    return it->second.tex;
+}
+
+static void drawCount(u32 count, int px, int py, u8 alpha) {
+    int w, h;
+    SDL_Texture* tex = getCountTex(count, w, h);
+    if (!tex) return;
+    SDL_Rect dst = {px - w / 2, py - h / 2, w, h};
+    SDL_SetTextureAlphaMod(tex, alpha);
+    SDL_RenderCopy(g_renderer, tex, nullptr, &dst);
+}
+
+// Uploads the map's image once the background build has finished
+static SDL_Texture* getHeatTex(int mapIdx) {
+    if (g_heatTex[mapIdx]) return g_heatTex[mapIdx];
+    HeatmapImage img;
+    if (!takeHeatmap(mapIdx, img)) return nullptr;
+    SDL_Texture* tex = SDL_CreateTexture(g_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, img.w, img.h);
+    if (tex) {
+        SDL_UpdateTexture(tex, nullptr, img.argb.data(), img.w * (int)sizeof(u32));
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    }
+    g_heatTex[mapIdx] = tex;
+    return tex;
+}
+
+static void drawHeatmap(const MapView& v) {
+    SDL_Texture* tex = getHeatTex(v.mapIdx);
+    if (!tex) return;
+    int w, h;
+    SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
+    const MapTransform& tr = g_profile.maps[v.mapIdx].transform;
+    double sx = w / tr.texW, sz = h / tr.texH;
+    SDL_Rect src = {(int)(v.srcX * sx), (int)(v.srcZ * sz), (int)(v.texW * sx), (int)(v.texH * sz)};
+    SDL_RenderCopy(g_renderer, tex, &src, &v.dst);
+}
+
+// Every location's hull faintly, the selected entry's on top in cyan
+static void drawRegions(const MapView& v) {
+    static std::vector<SDL_Vertex> verts;
+    static std::vector<SDL_Point>  outline;
+    const Region* sel = nullptr;
+    auto draw = [&](const Region& r, SDL_Color fill, SDL_Color line) {
+        int n = (int)r.hull.size() / 2;
+        verts.resize(n);
+        outline.resize(n + 1);
+        for (int i = 0; i < n; i++) {
+            float x = (float)(v.dst.x + (r.hull[2 * i] - v.srcX) * v.scale);
+            float y = (float)(v.dst.y + (r.hull[2 * i + 1] - v.srcZ) * v.scale);
+            verts[i] = {{x, y}, fill, {0, 0}};
+            outline[i] = {(int)x, (int)y};
+        }
+        outline[n] = outline[0];
+        SDL_RenderGeometry(g_renderer, nullptr, verts.data(), n, r.indices.data(), (int)r.indices.size());
+        SDL_SetRenderDrawColor(g_renderer, line.r, line.g, line.b, line.a);
+        SDL_RenderDrawLines(g_renderer, outline.data(), n + 1);
+    };
+    double x1 = v.srcX + v.texW, z1 = v.srcZ + v.texH;
+    for (const Region& r : regions(v.mapIdx)) {
+        if (r.maxX < v.srcX || r.minX > x1 || r.maxZ < v.srcZ || r.minZ > z1) continue;
+        if (g_selSpawner && g_selSpawner->mapIdx == v.mapIdx && g_selSpawner->location == r.location) {
+            sel = &r;
+            continue;
+        }
+        draw(r, {0xFF, 0xFF, 0xFF, 0x14}, {0xFF, 0xFF, 0xFF, 0x50});
+    }
+    if (sel) draw(*sel, {COL_CYAN.r, COL_CYAN.g, COL_CYAN.b, 0x40}, COL_CYAN);
+}
+
+// Spawners passing the map filter, walked by set bit
+static void drawFiltered(const MapView& v, const SpawnerBits& bits) {
+    static std::vector<SDL_Rect> dots;
+    dots.clear();
+    const FilterIndex& idx = g_filterIndex[v.mapIdx];
+    bits.forEach([&](u32 b) {
+        int px = v.screenX(idx.texX(b)), py = v.screenY(idx.texZ(b));
+        if (v.contains(px, py)) dots.push_back({px - 1, py - 1, 3, 3});
+    });
+    SDL_SetRenderDrawColor(g_renderer, COL_CYAN.r, COL_CYAN.g, COL_CYAN.b, 0xD0);
+    SDL_RenderFillRects(g_renderer, dots.data(), (int)dots.size());
+}
+
+static void drawLabels(const MapView& v) {
+    LabelLayer& layer = g_labels[v.mapIdx];
+    const MapTransform& tr = g_profile.maps[v.mapIdx].transform;
+    const std::vector<PlacedLabel>& placed = layer.layout((float)v.scale, tr.texW, tr.texH);
+    int ox = v.dst.x - (int)(v.srcX * v.scale), oy = v.dst.y - (int)(v.srcZ * v.scale);
+    for (const PlacedLabel& p : placed) {
+        const LabelAnchor& a = layer.anchors()[p.anchor];
+        SDL_Rect r = {ox + p.x, oy + p.y, a.w, a.h};
+        if (r.x < v.dst.x || r.y < v.dst.y || r.x + r.w > v.dst.x + v.dst.w || r.y + r.h > v.dst.y + v.dst.h)
+            continue;
+        auto it = g_labelCache.find(a.name);
+        if (it == g_labelCache.end())
+            it = g_labelCache.emplace(a.name, makeTextTex(g_fontSm, a.name, COL_WHITE)).first;
+        if (!it->second.tex) continue;
+        drawRect(r.x - 3, r.y, r.w + 6, r.h, {0x00, 0x00, 0x00, 0x90});
+        SDL_RenderCopy(g_renderer, it->second.tex, nullptr, &r);
+    }
+}
+
+// Visiting order through this map's stash entries, or through the
+// spawners the map filter passes while one is set, planned and refined
+// in the background; numbered from the first stop
+static constexpr size_t ROUTE_MAX_STOPS = 500;
+
+static void drawRoute(const MapView& v) {
+    struct Stop { u64 hash; float x, z; };
+    static std::vector<Stop> stops;
+    static std::vector<RoutePoint> pts;
+    static std::vector<int> order;
+    stops.clear();
+    const MapTransform& tr = g_profile.maps[v.mapIdx].transform;
+    const SDL_Color col = {0xFF, 0x99, 0x33, 0xFF};
+    if (const SpawnerBits* filtered = mapFilterBits(v.mapIdx)) {
+        const FilterIndex& idx = g_filterIndex[v.mapIdx];
+        filtered->forEach([&](u32 bit) {
+            const SpawnerEntry& sp = g_spawners[idx.spawner(bit)];
+            stops.push_back({sp.hash, sp.x, sp.z});
+        });
+    } else {
+        for (const ShinyEntry& e : g_entries) {
+            const SpawnerEntry* sp = findSpawner(e.hash);
+            if (sp && sp->mapIdx == v.mapIdx) stops.push_back({e.hash, sp->x, sp->z});
+        }
+    }
+    if (stops.size() < 2) return;
+    if (stops.size() > ROUTE_MAX_STOPS) {
+        char info[64];
+        snprintf(info, sizeof(info), "Route: %zu stops, filter to %zu or fewer", stops.size(), ROUTE_MAX_STOPS);
+        drawText(g_fontSm, info, v.dst.x + 6, v.dst.y + v.dst.h - 22, col);
+        return;
+    }
+
+    // Keyed by the set of stops, not the stash order
+    std::sort(stops.begin(), stops.end(), [](const Stop& a, const Stop& b) { return a.hash < b.hash; });
+    stops.erase(std::unique(stops.begin(), stops.end(), [](const Stop& a, const Stop& b) { return a.hash == b.hash; }),
+                stops.end());
+    pts.clear();
+    for (const Stop& st : stops) pts.push_back({st.x, st.z});
+    u64 key = digest64(stops.data(), stops.size() * sizeof(Stop)) ^ (u64)v.mapIdx;
+    bool done = false;
+    if (!g_routes.result(key, order, &done)) order.clear();   // drop the previous key's order
+    if (!done) g_routes.request(key, pts);
+    if (order.size() != pts.size()) return;
+
+    auto screen = [&](int i, int& px, int& py) {
+        px = v.screenX(tr.convertX(pts[i].x));
+        py = v.screenY(tr.convertZ(pts[i].z));
+    };
+    SDL_SetRenderDrawColor(g_renderer, 0xFF, 0x99, 0x33, 0xE0);
+    for (size_t i = 1; i < order.size(); i++) {
+        int x0, y0, x1, y1;
+        screen(order[i - 1], x0, y0);
+        screen(order[i], x1, y1);
+        SDL_RenderDrawLine(g_renderer, x0, y0, x1, y1);
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        int px, py;
+        screen(order[i], px, py);
+        if (v.contains(px, py)) drawCount((u32)(i + 1), px + 10, py - 10, 0xFF);
+    }
+
+    char info[64];
+    snprintf(info, sizeof(info), "Route: %zu stops, %.0f m%s", order.size(), routeLength(pts, order),
+             done ? "" : " (refining)");
+    drawText(g_fontSm, info, v.dst.x + 6, v.dst.y + v.dst.h - 22, col);
+}
+
+// Player marker with a line to the selected spawner, and the nearest
+// stash entry on this map
+static void drawPlayer(const MapView& v) {
+    const MapTransform& tr = g_profile.maps[v.mapIdx].transform;
+    int px = std::clamp(v.screenX(tr.convertX(g_playerPos.x)), v.dst.x + 4, v.dst.x + v.dst.w - 4);
+    int py = std::clamp(v.screenY(tr.convertZ(g_playerPos.z)), v.dst.y + 4, v.dst.y + v.dst.h - 4);
+
+    const SpawnerEntry* nearest = nullptr;
+    float nearDist = 0, nearDeg = 0;
+    for (const ShinyEntry& e : g_entries) {
+        const SpawnerEntry* sp = findSpawner(e.hash);
+        if (!sp || sp->mapIdx != v.mapIdx) continue;
+        float d, deg;
+        playerBearing(tr, g_playerPos, sp->x, sp->z, &d, &deg);
+        if (!nearest || d < nearDist) { nearest = sp; nearDist = d; nearDeg = deg; }
+    }
+
+    if (g_selSpawner && g_selSpawner->mapIdx == v.mapIdx) {
+        SDL_SetRenderDrawColor(g_renderer, COL_GREEN.r, COL_GREEN.g, COL_GREEN.b, 0x90);
+        SDL_RenderDrawLine(g_renderer, px, py, v.screenX(tr.convertX(g_selSpawner->x)),
+                           v.screenY(tr.convertZ(g_selSpawner->z)));
+    }
+    SDL_SetRenderDrawColor(g_renderer, COL_GREEN.r, COL_GREEN.g, COL_GREEN.b, 0xFF);
+    fillCircle(px, py, 6);
+    SDL_SetRenderDrawColor(g_renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    drawCircleOutline(px, py, 7);
+
+    if (nearest) {
+        char info[64];
+        snprintf(info, sizeof(info), "Nearest: %.0f m %s", nearDist, compassPoint(nearDeg));
+        drawTextRight(g_fontSm, info, v.dst.x + v.dst.w - 6, v.dst.y + v.dst.h - 22, COL_GREEN);
+    }
+}
+
+static int clusterRadius(u32 count) {
+    return std::min(12, 3 + (int)std::log2((float)count) * 2);
+}
+
+void renderMap() {
+    // Panel background
+    drawRect(MAP_AREA_X, MAP_AREA_Y, MAP_AREA_W, MAP_AREA_H, COL_PANEL);
+    drawBorder(MAP_AREA_X, MAP_AREA_Y, MAP_AREA_W, MAP_AREA_H, COL_BORDER);
+
+    int mapIdx = displayedMap();
+    MapView v;
+    if (mapView(mapIdx, v)) {
+        const MapTransform& tr = g_profile.maps[mapIdx].transform;
+        double imgX = g_mapW[mapIdx] / tr.texW, imgZ = g_mapH[mapIdx] / tr.texH;
+        SDL_Rect src = {(int)(v.srcX * imgX), (int)(v.srcZ * imgZ),
+                        (int)(v.texW * imgX), (int)(v.texH * imgZ)};
+        SDL_RenderCopy(g_renderer, g_mapTex[mapIdx], &src, &v.dst);
+        if (g_showHeatmap) drawHeatmap(v);
+        if (g_showRegions) drawRegions(v);
+
+        // Spawners, merged into clusters at least CLUSTER_CELL_PX apart;
+        // lone spawners stay tiny dim dots. With a map filter they fade
+        // (or are hidden) under the spawners that pass it.
+        static std::vector<Cluster> clusters;
+        clusters.clear();
+        const ClusterPyramid& pyr = g_clusters[mapIdx];
+        int level = pyr.levelFor((float)v.scale, CLUSTER_CELL_PX);
+        const SpawnerBits* filtered = mapFilterBits(mapIdx);
+        if (!filtered || !g_config.mapFilterHide)
+            pyr.query(level, (float)v.srcX, (float)v.srcZ,
+                      (float)(v.srcX + v.texW), (float)(v.srcZ + v.texH), clusters);
+        const int fade = filtered ? 2 : 1;
+        SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+        for (const Cluster& c : clusters) {
+            int px = v.screenX(c.texX), py = v.screenY(c.texZ);
+            if (!v.contains(px, py)) continue;
+            if (c.count == 1) {
+                SDL_SetRenderDrawColor(g_renderer, 0xFF, 0xFF, 0xFF, 0x20 / fade);
+                SDL_RenderDrawPoint(g_renderer, px, py);
+                continue;
+            }
+            SDL_SetRenderDrawColor(g_renderer, 0xFF, 0xFF, 0xFF, 0x28 / fade);
+            fillCircle(px, py, clusterRadius(c.count));
+            drawCount(c.count, px, py, 0x70 / fade);
+        }
+        if (filtered) drawFiltered(v, *filtered);
+
+        if (g_showLabels) drawLabels(v);
+
+        // Stash entries on this map as gold dots, grouped by the same cells
+        struct StashMark { float sx, sz; u32 count; int cx, cz; };
+        static std::vector<StashMark> marks;
+        marks.clear();
+        float cell = pyr.levels() ? pyr.cellSize(level) : CLUSTER_BASE_CELL;
+        for (int ei = 0; ei < (int)g_entries.size(); ei++) {
+            if (ei == g_selIdx) continue; // draw selected last
+            const SpawnerEntry* sp = findSpawner(g_entries[ei].hash);
+            if (!sp || sp->mapIdx != mapIdx) continue;
+            float texX = (float)tr.convertX(sp->x), texZ = (float)tr.convertZ(sp->z);
+            if (!v.contains(v.screenX(texX), v.screenY(texZ))) continue;
+            int cx = (int)std::floor(texX / cell), cz = (int)std::floor(texZ / cell);
+            size_t m = 0;
+            while (m < marks.size() && (marks[m].cx != cx || marks[m].cz != cz)) m++;
+            if (m == marks.size()) marks.push_back({0, 0, 0, cx, cz});
+            marks[m].sx += texX;
+            marks[m].sz += texZ;
+            marks[m].count++;
+        }
+        for (const StashMark& mk : marks) {
+            int px = v.screenX(mk.sx / mk.count), py = v.screenY(mk.sz / mk.count);
+            int r = mk.count > 1 ? 9 : 5;
+            SDL_SetRenderDrawColor(g_renderer, COL_GOLD.r, COL_GOLD.g, COL_GOLD.b, 0xCC);
+            fillCircle(px, py, r);
+            SDL_SetRenderDrawColor(g_renderer, 0x00, 0x00, 0x00, 0xAA);
+            drawCircleOutline(px, py, r);
+            if (mk.count > 1) drawCount(mk.count, px, py, 0xFF);
+        }
+
+        if (g_showRoute) drawRoute(v);
+
+        // Draw selected spawn point with crosshair
+        if (g_selSpawner && g_selSpawner->mapIdx == mapIdx) {
+            int px = v.screenX(tr.convertX(g_selSpawner->x));
+            int py = v.screenY(tr.convertZ(g_selSpawner->z));
+            px = std::clamp(px, v.dst.x + 4, v.dst.x + v.dst.w - 4);
+            py = std::clamp(py, v.dst.y + 4, v.dst.y + v.dst.h - 4);
+
+            // Outer ring
+            SDL_SetRenderDrawColor(g_renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+            drawCircleOutline(px, py, 12);
+            drawCircleOutline(px, py, 11);
+            // Filled dot
+            SDL_SetRenderDrawColor(g_renderer, COL_RED.r, COL_RED.g, COL_RED.b, 0xFF);
+            fillCircle(px, py, 8);
+            // Crosshair
+            SDL_SetRenderDrawColor(g_renderer, 0xFF, 0xFF, 0xFF, 0xCC);
+            SDL_RenderDrawLine(g_renderer, px - 18, py, px - 13, py);
+            SDL_RenderDrawLine(g_renderer, px + 13, py, px + 18, py);
+            SDL_RenderDrawLine(g_renderer, px, py - 18, px, py - 13);
+            SDL_RenderDrawLine(g_renderer, px, py + 13, px, py + 18);
+        }
+
+        if (g_havePlayer) drawPlayer(v);
+
+        // Free cursor, linked to its nearest spawner
+        if (g_cursorMode) {
+            int cx = v.screenX(g_cursorTexX), cy = v.screenY(g_cursorTexZ);
+            SDL_SetRenderDrawColor(g_renderer, COL_CYAN.r, COL_CYAN.g, COL_CYAN.b, 0xFF);
+            if (g_cursorHit >= 0) {
+                const SpawnerEntry& sp = g_spawners[g_cursorHit];
+                int px = v.screenX(tr.convertX(sp.x)), py = v.screenY(tr.convertZ(sp.z));
+                SDL_RenderDrawLine(g_renderer, cx, cy, px, py);
+                drawCircleOutline(px, py, 7);
+                drawCircleOutline(px, py, 6);
+            }
+            SDL_RenderDrawLine(g_renderer, cx - 10, cy, cx + 10, cy);
+            SDL_RenderDrawLine(g_renderer, cx, cy - 10, cx, cy + 10);
+        }
+        // Map name label
+        drawText(g_fontSm, g_profile.maps[mapIdx].name.c_str(), v.dst.x + 6, v.dst.y + 4, {0xFF, 0xFF, 0xFF, 0x88});
+        if (g_mapZoom > 1) {
+            char zoom[8];
+            snprintf(zoom, sizeof(zoom), "x%d", g_mapZoom);
+            drawTextRight(g_fontSm, zoom, v.dst.x + v.dst.w - 6, v.dst.y + 4, {0xFF, 0xFF, 0xFF, 0x88});
+        }
+        if (filtered) {
+            char buf[160];
+            snprintf(buf, sizeof(buf), "Filter: %s (%u, %.1f us)", g_filter.text().c_str(),
+                     g_filterCount, g_filterNs / 1000.0);
+            drawText(g_fontSm, buf, v.dst.x + 6, v.dst.y + v.dst.h - 22, {0x40, 0xC8, 0xFF, 0xCC});
+        }
+    } else if (!g_entries.empty()) {
+        drawText(g_fontMd, "Unknown spawn location", MAP_AREA_X + 200, MAP_AREA_Y + 300, COL_DIMGRAY);
+    } else {
+        drawText(g_fontMd, "No location selected", MAP_AREA_X + 220, MAP_AREA_Y + 300, COL_DIMGRAY);
+    }
+}
+
+void renderInfo() {
+    int y = INFO_Y;
+    if (g_cursorMode) {
+        drawText(g_fontSm, g_profile.maps[g_cursorMap].name.c_str(), MAP_AREA_X + 4, y, COL_CYAN);
+        if (g_cursorHit >= 0) {
+            const SpawnerEntry& sp = g_spawners[g_cursorHit];
+            drawText(g_fontSm, sp.location, MAP_AREA_X + 160, y, COL_GRAY);
+            char buf[64];
+            snprintf(buf, sizeof(buf), "%016llX  %.1f m", (unsigned long long)sp.hash, g_cursorDist);
+            drawTextRight(g_fontSm, buf, MAP_AREA_X + MAP_AREA_W, y, COL_DIMGRAY);
+        } else {
+            drawText(g_fontSm, "No spawners on this map", MAP_AREA_X + 160, y, COL_DIMGRAY);
+        }
+    } else if (g_selSpawner) {
+        drawText(g_fontSm, g_profile.maps[g_selSpawner->mapIdx].name.c_str(), MAP_AREA_X + 4, y, COL_CYAN);
+        drawText(g_fontSm, g_selSpawner->location, MAP_AREA_X + 160, y, COL_GRAY);
+
+        char buf[96];
+        snprintf(buf, sizeof(buf), "X: %.1f  Y: %.1f  Z: %.1f", g_selSpawner->x, g_selSpawner->y, g_selSpawner->z);
+        drawTextRight(g_fontSm, buf, MAP_AREA_X + MAP_AREA_W, y, COL_DIMGRAY);
+    } else if (!g_entries.empty() && g_selIdx < (int)g_entries.size()) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "Hash: %016llX", (unsigned long long)g_entries[g_selIdx].hash);
+        drawText(g_fontSm, buf, MAP_AREA_X + 4, y, COL_DIMGRAY);
+    } else if (!g_detectedBid.empty()) {
+        std::string bidLine = "BID: " + g_detectedBid;
+        drawText(g_fontSm, bidLine.c_str(), MAP_AREA_X + 4, y, COL_CYAN);
+        drawText(g_fontSm, g_statusMsg.c_str(), MAP_AREA_X + 240, y, COL_RED);
+    } else {
+        drawText(g_fontSm, g_statusMsg.c_str(), MAP_AREA_X + 4, y, COL_DIMGRAY);
+    }
+
+    // Controls: the main ones only, the About screen lists them all
+    const char* controls =
+        g_browseMode ? "Type/Y: Search  B: Erase  Up/Down: Row  Left/Right: Page  L: Filter  RS: Close" :
+        g_cursorMode ? "Stick/Touch: Move cursor    L: Next map    ZL/ZR: Zoom    R: Leave cursor" :
+                       "A: Read  Y: Live  R: Cursor  RS: Browse  L: Filter  ZL/ZR: Zoom  -: All controls";
+    drawText(g_fontSm, controls, MAP_AREA_X + 4, y + 19, {0x44,0x44,0x44,0xFF});
+
+    if (g_liveMode) {
+        const StashStats& st = g_reader.stats();
+        char live[128];
+        int n = snprintf(live, sizeof(live), "LIVE  %llu polls  %llu changes  check %llu ns  ipc %llu%s",
+                         (unsigned long long)st.polls, (unsigned long long)st.changes,
+                         (unsigned long long)st.lastDigestNs, (unsigned long long)st.lastIpc,
+                         g_reader.cheatActive() ? " (vm)" : "");
+        if (st.pauses)
+            snprintf(live + n, sizeof(live) - n, "  pause %llu us",
+                     (unsigned long long)(st.lastPauseNs / 1000));
+        else if (g_config.snapshot.mode != SnapshotMode::Plain && st.reads)
+            snprintf(live + n, sizeof(live) - n, "  torn %.1f%%",
+                     100.0 * (double)st.tornReads / (double)st.reads);
+        drawText(g_fontSm, live, MAP_AREA_X + 4, y + 38, COL_GOLD);
+    }
+}
+
+// Every spawner, grouped by map and location; only the rows on screen
+// are drawn, so the cost does not grow with the spawner count
+static void renderBrowser() {
+    char title[64];
+    snprintf(title, sizeof(title), "Spawners (%u/%u)", g_browseMatches, g_search.size());
+    drawText(g_fontLg, title, LIST_X + 8, LIST_Y, COL_GOLD);
+
+    std::string query = "Search: " + g_browseQuery + "_";
+    drawText(g_fontSm, query.c_str(), LIST_X + 8, LIST_Y + 40, COL_WHITE);
+    char took[32];
+    snprintf(took, sizeof(took), "%.1f us", g_browseFilterNs / 1000.0);
+    drawTextRight(g_fontSm, took, LIST_X + LIST_W - 10, LIST_Y + 40, COL_DIMGRAY);
+    int headerH = 66;
+    SDL_SetRenderDrawColor(g_renderer, COL_BORDER.r, COL_BORDER.g, COL_BORDER.b, 0xFF);
+    SDL_RenderDrawLine(g_renderer, LIST_X, LIST_Y + headerH, LIST_X + LIST_W, LIST_Y + headerH);
+
+    int listTop = LIST_Y + headerH + 10;
+    int listH = SCREEN_H - 30 - listTop;
+    if (g_browseRows.empty()) {
+        drawText(g_fontMd, "No matching spawners", LIST_X + 12, listTop + 20, COL_GRAY);
+        return;
+    }
+
+    // Keep the selection on screen, with the headers above it where they fit
+    const int total = (int)g_browseRows.size();
+    const int maxVis = std::max(1, browseVisibleRows());
+    if (g_browseSel >= 0) {
+        if (g_browseSel < g_browseScroll) {
+            g_browseScroll = g_browseSel;
+            while (g_browseScroll > 0 && g_browseRows[g_browseScroll - 1].kind != BrowserRow::Spawner)
+                g_browseScroll--;
+        } else if (g_browseSel >= g_browseScroll + maxVis) {
+            g_browseScroll = g_browseSel - maxVis + 1;
+        }
+    }
+    g_browseScroll = std::clamp(g_browseScroll, 0, std::max(0, total - maxVis));
+
+    for (int vi = 0; vi < maxVis && g_browseScroll + vi < total; vi++) {
+        int ri = g_browseScroll + vi;
+        const BrowserRow& row = g_browseRows[ri];
+        const SpawnerEntry& sp = g_spawners[g_search.spawnerAt(row.pos)];
+        int iy = listTop + vi * BROWSE_ROW_H;
+        char buf[64];
+        switch (row.kind) {
+            case BrowserRow::Map:
+                drawText(g_fontMd, g_profile.maps[sp.mapIdx].name.c_str(), LIST_X + 8, iy, COL_GOLD);
+                snprintf(buf, sizeof(buf), "%u", row.count);
+                drawTextRight(g_fontSm, buf, LIST_X + LIST_W - 10, iy + 4, COL_GOLD);
+                break;
+            case BrowserRow::Location:
+                drawText(g_fontSm, sp.location, LIST_X + 20, iy + 4, COL_CYAN);
+                snprintf(buf, sizeof(buf), "%u", row.count);
+                drawTextRight(g_fontSm, buf, LIST_X + LIST_W - 10, iy + 4, COL_DIMGRAY);
+                break;
+            case BrowserRow::Spawner: {
+                bool sel = ri == g_browseSel;
+                if (sel) drawRect(LIST_X, iy, LIST_W, BROWSE_ROW_H - 2, COL_SEL);
+                bool stashed = false;
+                for (const ShinyEntry& e : g_entries) stashed |= e.hash == sp.hash;
+                if (stashed) {
+                    SDL_SetRenderDrawColor(g_renderer, COL_GOLD.r, COL_GOLD.g, COL_GOLD.b, 0xFF);
+                    fillCircle(LIST_X + 26, iy + 12, 4);
+                }
+                snprintf(buf, sizeof(buf), "%016llX", (unsigned long long)sp.hash);
+                drawText(g_fontSm, buf, LIST_X + 38, iy + 4, sel ? COL_WHITE : COL_GRAY);
+                snprintf(buf, sizeof(buf), "%.0f, %.0f", sp.x, sp.z);
+                drawTextRight(g_fontSm, buf, LIST_X + LIST_W - 10, iy + 4, COL_DIMGRAY);
+                break;
+            }
+        }
+    }
+
+    if (total > maxVis) {
+        int thumbH = std::max(20, listH * maxVis / total);
+        int thumbY = listTop + (listH - thumbH) * g_browseScroll / std::max(1, total - maxVis);
+        drawRect(LIST_X + LIST_W - 4, thumbY, 4, thumbH, COL_BORDER);
+    }
+}
+
+void renderList() {
+    // Panel
+    drawRect(LIST_X - 10, LIST_Y - 10, LIST_W + 20, SCREEN_H - 20, COL_PANEL);
+    drawBorder(LIST_X - 10, LIST_Y - 10, LIST_W + 20, SCREEN_H - 20, COL_BORDER);
+    if (g_browseMode) {
+        renderBrowser();
+        return;
+    }
+
+    // Title
+    char title[64];
+    if (g_entries.empty())
+        snprintf(title, sizeof(title), "Shiny Stash");
+    else
+        snprintf(title, sizeof(title), "Shiny Stash (%d)", (int)g_entries.size());
+    drawText(g_fontLg, title, LIST_X + 8, LIST_Y, COL_GOLD);
+    int headerH = 40;
+
+    // Separator
+    SDL_SetRenderDrawColor(g_renderer, COL_BORDER.r, COL_BORDER.g, COL_BORDER.b, 0xFF);
+    SDL_RenderDrawLine(g_renderer, LIST_X, LIST_Y + headerH, LIST_X + LIST_W, LIST_Y + headerH);
+
+    int listTop = LIST_Y + headerH + 6;
+    int listH = SCREEN_H - 30 - listTop;
+
+    if (g_entries.empty()) {
+        drawText(g_fontMd, g_statusMsg.c_str(), LIST_X + 12, listTop + 20, COL_GRAY);
+        return;
+    }
+
+    // Visible entries
+    int maxVis = listH / ITEM_H;
+    if (maxVis < 1) maxVis = 1;
+
+    if (g_selIdx < g_scrollOff)
+        g_scrollOff = g_selIdx;
+    else if (g_selIdx >= g_scrollOff + maxVis)
+        g_scrollOff = g_selIdx - maxVis + 1;
+
+    // Distances only for entries on the displayed map, where the player is
+    const int shownMap = displayedMap();
+    const MapTransform* playerTr = g_havePlayer ? &g_profile.maps[shownMap].transform : nullptr;
+
+    for (int vi = 0; vi < maxVis && (vi + g_scrollOff) < (int)g_entries.size(); vi++) {
+        int idx = vi + g_scrollOff;
+        int iy = listTop + vi * ITEM_H;
+        bool sel = (idx == g_selIdx);
+
+        // Selection bg
+        if (sel)
+            drawRect(LIST_X, iy, LIST_W, ITEM_H - 4, COL_SEL);
+
+        // Pokemon image
+        const ShinyEntry& e = g_entries[idx];
+        int textOffX = 14;
+        SDL_Texture* spriteTex = e.checksumOk ? getSpriteTex(e.nationalDex) : nullptr;
+        if (spriteTex) {
+            SDL_Rect dst = {LIST_X + 10, iy + (ITEM_H - 4 - SPRITE_SIZE) / 2, SPRITE_SIZE, SPRITE_SIZE};
+            SDL_RenderCopy(g_renderer, spriteTex, nullptr, &dst);
+            textOffX = 10 + SPRITE_SIZE + 6;
+        }
+
+        // Species name and dex number; a failed checksum means the species is garbage
+        if (e.checksumOk) {
+            drawText(g_fontMd, getSpeciesName(e.nationalDex), LIST_X + textOffX, iy + 4,
+                     sel ? COL_WHITE : SDL_Color{0xCC, 0xCC, 0xCC, 0xFF});
+            char num[16];
+            snprintf(num, sizeof(num), "#%03u", e.nationalDex);
+            drawTextRight(g_fontSm, num, LIST_X + LIST_W - 10, iy + 6, COL_DIMGRAY);
+        } else {
+            drawText(g_fontMd, "Unreadable entry", LIST_X + textOffX, iy + 4, COL_RED);
+            drawTextRight(g_fontSm, "bad checksum", LIST_X + LIST_W - 10, iy + 6, COL_DIMGRAY);
+        }
+
+        // Location name on second line
+        const SpawnerEntry* sp = findSpawner(e.hash);
+        static std::string spName;
+        if (sp) {
+            drawText(g_fontSm, sp->location, LIST_X + textOffX, iy + 30, COL_DIMGRAY);
+            if (playerTr && sp->mapIdx == shownMap) {
+                // Live distance and bearing from the player
+                float d, deg;
+                playerBearing(*playerTr, g_playerPos, sp->x, sp->z, &d, &deg);
+                char rel[32];
+                snprintf(rel, sizeof(rel), "%.0f m %s", d, compassPoint(deg));
+                drawTextRight(g_fontSm, rel, LIST_X + LIST_W - 10, iy + 30, COL_GREEN);
+            } else {
+                drawTextRight(g_fontSm, g_profile.maps[sp->mapIdx].name.c_str(), LIST_X + LIST_W - 10, iy + 30, {0x44,0x66,0x88,0xFF});
+            }
+        } else if (g_spawnerNames.name(e.hash, spName)) {
+            // Named by hash lookup, but not in the spawner files: no position
+            drawText(g_fontSm, spName.c_str(), LIST_X + textOffX, iy + 30, {0x88,0x66,0x66,0xFF});
+            drawTextRight(g_fontSm, "not on the maps", LIST_X + LIST_W - 10, iy + 30, {0x66,0x44,0x44,0xFF});
+        } else {
+            drawText(g_fontSm, "Unknown location", LIST_X + textOffX, iy + 30, {0x66,0x44,0x44,0xFF});
+            char hex[24];
+            snprintf(hex, sizeof(hex), "%016llX", (unsigned long long)e.hash);
+            drawTextRight(g_fontSm, g_spawnerNames.searched(e.hash) ? hex : "Looking up name...",
+                          LIST_X + LIST_W - 10, iy + 30, {0x66,0x44,0x44,0xFF});
+        }
+
+        // Bottom separator
+        if (vi < maxVis - 1 && (vi + g_scrollOff + 1) < (int)g_entries.size()) {
+            SDL_SetRenderDrawColor(g_renderer, 0x28, 0x28, 0x42, 0xFF);
+            SDL_RenderDrawLine(g_renderer, LIST_X + 10, iy + ITEM_H - 4,
+                               LIST_X + LIST_W - 10, iy + ITEM_H - 4);
+        }
+    }
+
+    // Scroll indicator
+    if ((int)g_entries.size() > maxVis) {
+        int thumbH = std::max(20, listH * maxVis / (int)g_entries.size());
+        int maxScr = std::max(1, (int)g_entries.size() - maxVis);
+        int thumbY = listTop + (listH - thumbH) * g_scrollOff / maxScr;
+        drawRect(LIST_X + LIST_W - 4, thumbY, 4, thumbH, COL_BORDER);
+    }
+}
+
+// ============================================================
+// Initialization / Cleanup
+// ============================================================
+
+bool initSDL() {
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK) < 0) return false;
+    if (IMG_Init(IMG_INIT_PNG) == 0) return false;
+    if (TTF_Init() < 0) return false;
+
+    g_window = SDL_CreateWindow("ZA Shiny Map",
+        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+        SCREEN_W, SCREEN_H, SDL_WINDOW_SHOWN);
+    if (!g_window) return false;
+
+    g_renderer = SDL_CreateRenderer(g_window, -1,
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!g_renderer) return false;
+
+    SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+bool initFonts() {
+    PlFontData fontData;
+    Result rc = plGetSharedFontByType(&fontData, PlSharedFontType_Standard);
+    if (R_FAILED(rc)) return false;
+
+    g_fontLg = TTF_OpenFontRW(SDL_RWFromMem(fontData.address, fontData.size), 1, 26);
+    g_fontMd = TTF_OpenFontRW(SDL_RWFromMem(fontData.address, fontData.size), 1, 20);
+    g_fontSm = TTF_OpenFontRW(SDL_RWFromMem(fontData.address, fontData.size), 1, 15);
+    return g_fontLg && g_fontMd && g_fontSm;
+}
+
+void cleanup() {
+    stopRegionBuild();
+    stopHeatmapBuild();
+    g_routes.stop();
+    g_spawnerNames.stop();
+    if (g_pauseLog) fclose(g_pauseLog);
+    g_pauseLog = nullptr;
+    for (auto& p : g_spriteCache)
+        if (p.second) SDL_DestroyTexture(p.second);
+    g_spriteCache.clear();
+    for (auto& p : g_countCache)
+        if (p.second.tex) SDL_DestroyTexture(p.second.tex);
+    g_countCache.clear();
+    for (auto& p : g_labelCache)
+        if (p.second.tex) SDL_DestroyTexture(p.second.tex);
+    g_labelCache.clear();
+    for (int i = 0; i < MAP_MAX; i++) {
+        if (g_mapTex[i]) SDL_DestroyTexture(g_mapTex[i]);
+        if (g_heatTex[i]) SDL_DestroyTexture(g_heatTex[i]);
+    }
+    if (g_fontLg) TTF_CloseFont(g_fontLg);
+    if (g_fontMd) TTF_CloseFont(g_fontMd);
+    if (g_fontSm) TTF_CloseFont(g_fontSm);
+    if (g_renderer) SDL_DestroyRenderer(g_renderer);
+    if (g_window) SDL_DestroyWindow(g_window);
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+// ============================================================
+// About Screen
+// ============================================================
+
+void renderAbout() {
+    int bw = 700, bh = 560;
+    int bx = (SCREEN_W - bw) / 2, by = (SCREEN_H - bh) / 2;
+
+    // Dim background
+    drawRect(0, 0, SCREEN_W, SCREEN_H, {0x00, 0x00, 0x00, 0xBB});
+    // Panel
+    drawRect(bx, by, bw, bh, COL_PANEL);
+    drawBorder(bx, by, bw, bh, COL_BORDER);
+
+    int x = bx + 30, y = by + 24;
+    drawText(g_fontLg, "Lumiose - Shiny Stash Live Map", x, y, COL_GOLD);
+    y += 40;
+    drawText(g_fontSm, "v" APP_VERSION " - Developed by Insektaure (github.com/Insektaure)", x, y, COL_DIMGRAY);
+    y += 20;
+    if (g_gameVersion.empty())
+        drawText(g_fontSm, "Supported: 1.0.0/1.0.1, 1.0.2, 1.0.3, 2.0.0, 2.0.1, 2.0.2", x, y, COL_GRAY);
+    else {
+        std::string verStr = "Game version: " + g_gameVersion;
+        drawText(g_fontSm, verStr.c_str(), x, y, COL_GRAY);
+    }
+    const ScanResult& scan = g_reader.lastScan();
+    if (scan.elapsedNs) {
+        y += 20;
+        char line[128];
+        if (g_reader.lastScanFound())
+            snprintf(line, sizeof(line), "Stash pointer auto-detected: +0x%llX (%u/%u candidates, %llu ms)",
+                     (unsigned long long)scan.basePointer, scan.validated, scan.candidates,
+                     (unsigned long long)(scan.elapsedNs / 1000000));
+        else
+            snprintf(line, sizeof(line), "Auto-detect found no stash: %u/%u candidates, %u unreachable, %llu ms",
+                     scan.validated, scan.candidates, scan.unreachable,
+                     (unsigned long long)(scan.elapsedNs / 1000000));
+        drawText(g_fontSm, line, x, y, COL_GRAY);
+    }
+    y += 30;
+
+    SDL_SetRenderDrawColor(g_renderer, COL_BORDER.r, COL_BORDER.g, COL_BORDER.b, 0xFF);
+    SDL_RenderDrawLine(g_renderer, bx + 20, y, bx + bw - 20, y);
+    y += 16;
+
+    drawText(g_fontMd, "Reads the Shiny Stash from Pokemon Legends: Z-A", x, y, COL_WHITE);
+    y += 28;
+    drawText(g_fontMd, "and displays spawn locations on the map.", x, y, COL_WHITE);
+    y += 42;
+
+    drawText(g_fontSm, "Based on ShinyStashMap plugin by santacrab2 & PKHeX by kwsch.", x, y, COL_GRAY);
+    y += 22;
+    drawText(g_fontSm, "Requires Atmosphere CFW with dmnt:cht enabled.", x, y, COL_GRAY);
+    y += 38;
+
+    drawText(g_fontSm, "Controls:", x, y, COL_CYAN);
+    y += 24;
+    drawText(g_fontSm, "A: Read shiny stash from game memory", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "D-Pad Up/Down: Navigate the stash list", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "Y: Live mode (re-read the stash automatically)", x + 16, y, COL_GRAY);
+    y += 20;
+    if (speciesPacksInstalled()) {
+        drawText(g_fontSm, "X: Species name language", x + 16, y, COL_GRAY);
+        y += 20;
+    }
+    drawText(g_fontSm, "R / Touch: Map cursor (stick moves, L switches map)", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "ZL/ZR: Zoom the map out/in", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "L: Map filter (stash, selected location, map_filter, off)", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "R-Stick click: Spawner browser (type, or Y for the keyboard)", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "D-Pad Left: Heatmap   Right: Labels   B: Regions   L-Stick click: Route", x + 16, y, COL_GRAY);
+    y += 20;
+    drawText(g_fontSm, "-: Toggle this screen    +: Exit", x + 16, y, COL_GRAY);
+    y += 34;
+
+    drawTextRight(g_fontSm, "Press - or B to close", bx + bw - 30, by + bh - 30, COL_DIMGRAY);
+}
+
+// ============================================================
+// Frame
+// ============================================================
+
+void renderFrame() {
+    SDL_SetRenderDrawColor(g_renderer, COL_BG.r, COL_BG.g, COL_BG.b, 0xFF);
+    SDL_RenderClear(g_renderer);
+
+    // One interpolated player position for the whole frame. The maps
+    // share world coordinates, so the player's map comes from the zone id
+    // (player_map_chain); without one, the player is assumed to be on the
+    // selected entry's map.
+    g_havePlayer = false;
+    int mapIdx = displayedMap(), playerMap = -1;
+    if (mapIdx >= 0 && g_player.running() && g_player.position(nowNs(), g_playerPos, &playerMap)) {
+        bool onMap = g_profile.playerMapChainLen ? playerMap == mapIdx
+                                                 : g_selSpawner && g_selSpawner->mapIdx == mapIdx;
+        const MapTransform& tr = g_profile.maps[mapIdx].transform;
+        double tx = tr.convertX(g_playerPos.x), tz = tr.convertZ(g_playerPos.z);
+        g_havePlayer = onMap && tx >= 0 && tx <= tr.texW && tz >= 0 && tz <= tr.texH;
+    }
+
+    renderMap();
+    renderInfo();
+    renderList();
+    if (g_showAbout) renderAbout();
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <switch.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <string>
+#include <vector>
+
+#include "reader.h"
+#include "spawners.h"
+#include "stash.h"
+
+class MemorySource;
+
+// ============================================================
+// Constants
+// ============================================================
+
+static constexpr int SCREEN_W = 1280;
+static constexpr int SCREEN_H = 720;
+
+// Layout
+static constexpr int MAP_AREA_X = 20;
+static constexpr int MAP_AREA_Y = 20;
+static constexpr int MAP_AREA_W = 680;
+static constexpr int MAP_AREA_H = 630;
+static constexpr int INFO_Y     = MAP_AREA_Y + MAP_AREA_H + 8;
+static constexpr int LIST_X     = MAP_AREA_X + MAP_AREA_W + 20;
+static constexpr int LIST_Y     = 20;
+static constexpr int LIST_W     = SCREEN_W - LIST_X - 20;
+static constexpr int ITEM_H     = 62;
+static constexpr int MAP_ZOOM_MAX = 16;
+
+// Colors (SDL)
+static constexpr SDL_Color COL_BG       = {0x16, 0x16, 0x2B, 0xFF};
+static constexpr SDL_Color COL_PANEL    = {0x1E, 0x1E, 0x38, 0xFF};
+static constexpr SDL_Color COL_SEL      = {0x1A, 0x3A, 0x6E, 0xFF};
+static constexpr SDL_Color COL_BORDER   = {0x30, 0x30, 0x55, 0xFF};
+static constexpr SDL_Color COL_WHITE    = {0xFF, 0xFF, 0xFF, 0xFF};
+static constexpr SDL_Color COL_GRAY     = {0x88, 0x88, 0x88, 0xFF};
+static constexpr SDL_Color COL_DIMGRAY  = {0x55, 0x55, 0x55, 0xFF};
+static constexpr SDL_Color COL_GOLD     = {0xFF, 0xD7, 0x00, 0xFF};
+static constexpr SDL_Color COL_CYAN     = {0x40, 0xC8, 0xFF, 0xFF};
+static constexpr SDL_Color COL_RED      = {0xFF, 0x33, 0x33, 0xFF};
+static constexpr SDL_Color COL_GREEN    = {0x4C, 0xE0, 0x6A, 0xFF};
+
+// ============================================================
+// Global State
+// ============================================================
+
+extern SDL_Window*   g_window;
+extern SDL_Renderer* g_renderer;
+extern TTF_Font*     g_fontLg;   // 26
+extern TTF_Font*     g_fontMd;   // 20
+extern TTF_Font*     g_fontSm;   // 15
+
+extern std::vector<ShinyEntry>   g_entries;
+
+extern int  g_selIdx;
+extern int  g_scrollOff;
+extern const SpawnerEntry* g_selSpawner;
+extern std::string g_statusMsg;
+extern std::string g_gameVersion;
+extern std::string g_detectedBid;
+extern bool g_showAbout;
+
+extern MemorySource* g_mem;
+extern StashReader   g_reader;
+extern bool g_liveMode;          // poll the stash every config.liveIntervalMs
+extern bool g_cursorMode;        // free cursor on the map panel
+extern bool g_showLabels;        // location names on the map
+extern bool g_showHeatmap;       // spawner density overlay
+extern bool g_showRegions;       // location hull outlines
+extern bool g_showRoute;         // planned visiting order of stash entries
+extern bool g_browseMode;        // list panel shows every spawner, with search
+extern int  g_mapZoom;           // 1, 2, 4 ... MAP_ZOOM_MAX
+extern u64  g_entriesVersion;    // bumped whenever g_entries is rebuilt
+
+// ============================================================
+// Application
+// ============================================================
+
+bool initSDL();
+bool initFonts();
+void loadData();
+void cleanup();
+
+void updateSelection();
+void readShinyStash();
+void setLiveMode(bool on);
+void pollStash();      // no-op unless a scan or read is due to continue, or a live poll is due
+
+void zoomMap(int dir);       // > 0 zooms in one step, < 0 out
+void setCursorMode(bool on);
+void cycleCursorMap();
+void moveCursor(int stickX, int stickY);   // HidAnalogStickState units
+bool touchMap(int x, int y);               // screen pixels; false if off the map
+
+enum MapFilterPreset { FILTER_OFF, FILTER_STASH, FILTER_LOCATION, FILTER_CUSTOM, FILTER_PRESET_COUNT };
+void setMapFilter(int preset);   // MapFilterPreset; FILTER_CUSTOM is config map_filter
+void cycleMapFilter();           // next preset that has something to filter by
+
+void setBrowseMode(bool on);
+void browseMove(int delta);   // spawner rows; the map follows the selection
+void browsePage(int dir);
+void browseType(char c);      // appends to the search
+void browseErase();           // drops the last search character
+void browseKeyboard();        // edits the search with the software keyboard
+
+void renderMap();
+void renderInfo();
+void renderList();
+void renderAbout();
+void renderFrame();   // clear + all panels (+ About overlay when shown)
@@ -0,0 +1,78 @@
+#include "cluster.h"
+
+#include <algorithm>
+#include <cmath>
+
+ClusterPyramid g_clusters[MAP_MAX];
+
+void ClusterPyramid::build(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr) {
+    clear();
+    // Sums rather than centroids, so merging cells is exact
+    struct Cell { u32 cx, cz; double sx, sz; u32 n; };
+    std::vector<Cell> cur;
+    for (const auto& sp : spawners) {
+        if (sp.mapIdx != mapIdx) continue;
+        double tx = tr.convertX(sp.x), tz = tr.convertZ(sp.z);
+        if (tx < 0 || tx >= tr.texW || tz < 0 || tz >= tr.texH) continue;
+        cur.push_back({(u32)(tx / CLUSTER_BASE_CELL), (u32)(tz / CLUSTER_BASE_CELL), tx, tz, 1});
+    }
+    if (cur.empty()) return;
+
+    int cols = (int)std::ceil(tr.texW / CLUSTER_BASE_CELL);
+    int rows = (int)std::ceil(tr.texH / CLUSTER_BASE_CELL);
+    for (;;) {
+        std::sort(cur.begin(), cur.end(), [](const Cell& a, const Cell& b) {
+            return a.cz != b.cz ? a.cz < b.cz : a.cx < b.cx;
+        });
+        size_t n = 0;
+        for (size_t i = 0; i < cur.size(); i++) {
+            if (n && cur[n - 1].cx == cur[i].cx && cur[n - 1].cz == cur[i].cz) {
+                cur[n - 1].sx += cur[i].sx;
+                cur[n - 1].sz += cur[i].sz;
+                cur[n - 1].n  += cur[i].n;
+            } else {
+                cur[n++] = cur[i];
+            }
+        }
+        cur.resize(n);
+
+        Level& lv = m_levels.emplace_back();
+        lv.cols = cols;
+        lv.rows = rows;
+        lv.rowStart.assign(rows + 1, 0);
+        lv.cellX.reserve(n);
+        lv.cells.reserve(n);
+        for (const Cell& c : cur) {
+            lv.rowStart[c.cz + 1]++;
+            lv.cellX.push_back(c.cx);
+            lv.cells.push_back({(float)(c.sx / c.n), (float)(c.sz / c.n), c.n});
+        }
+        for (int r = 1; r <= rows; r++) lv.rowStart[r] += lv.rowStart[r - 1];
+
+        if (cols <= 1 && rows <= 1) break;
+        for (Cell& c : cur) { c.cx >>= 1; c.cz >>= 1; }
+        cols = (cols + 1) / 2;
+        rows = (rows + 1) / 2;
+    }
+}
+
+int ClusterPyramid::levelFor(float pxPerTex, float minCellPx) const {
+    for (int l = 0; l < levels(); l++)
+        if (cellSize(l) * pxPerTex >= minCellPx) return l;
+    return levels() - 1;
+}
+
+void ClusterPyramid::query(int level, float x0, float z0, float x1, float z1, std::vector<Cluster>& out) const {
+    if (level < 0 || level >= levels()) return;
+    const Level& lv = m_levels[level];
+    float inv = 1.0f / cellSize(level);
+    int c0 = std::max(0, (int)std::floor(x0 * inv)), c1 = std::min(lv.cols - 1, (int)std::floor(x1 * inv));
+    int r0 = std::max(0, (int)std::floor(z0 * inv)), r1 = std::min(lv.rows - 1, (int)std::floor(z1 * inv));
+    if (c0 > c1) return;
+    for (int r = r0; r <= r1; r++) {
+        auto begin = lv.cellX.begin() + lv.rowStart[r], end = lv.cellX.begin() + lv.rowStart[r + 1];
+        for (auto it = std::lower_bound(begin, end, (u32)c0); it != end && *it <= (u32)c1; ++it)
+            out.push_back(lv.cells[it - lv.cellX.begin()]);
+    }
+}
+
@@ -0,0 +1,55 @@
+#pragma once
+#include <switch.h>
+
+#include <vector>
+
+#include "profile.h"
+#include "spawners.h"
+
+// ============================================================
+// Marker Clusters
+// ============================================================
+//
+// Grid pyramid over one map's spawners in texture pixels. Level 0 uses
+// CLUSTER_BASE_CELL-pixel cells and every level above merges 2x2 cells
+// of the one below, so a cluster's count and centroid are exact sums of
+// its children. The renderer picks the level whose cells are at least
+// a glyph wide on screen and asks only for visible cells, which caps the
+// markers drawn per frame by screen area rather than by spawner count.
+//
+// Spawners outside the map image are left out, as they are never drawn.
+
+static constexpr float CLUSTER_BASE_CELL = 4.0f;
+
+struct Cluster {
+    float texX, texZ;   // centroid
+    u32   count;
+};
+
+class ClusterPyramid {
+public:
+    void build(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr);
+    void clear() { m_levels.clear(); }
+
+    int   levels() const { return (int)m_levels.size(); }
+    float cellSize(int level) const { return CLUSTER_BASE_CELL * (float)(1 << level); }
+
+    // Finest level whose cells span at least `minCellPx` screen pixels
+    // at `pxPerTex` screen pixels per texture pixel.
+    int levelFor(float pxPerTex, float minCellPx) const;
+
+    // Appends the clusters of `level` whose cells overlap the texture
+    // rectangle [x0, x1] x [z0, z1].
+    void query(int level, float x0, float z0, float x1, float z1, std::vector<Cluster>& out) const;
+
+private:
+    struct Level {
+        int cols = 0, rows = 0;
+        std::vector<u32>     rowStart;   // rows + 1, into cellX / cells
+        std::vector<u32>     cellX;      // column of each cell, ascending per row
+        std::vector<Cluster> cells;
+    };
+    std::vector<Level> m_levels;
+};
+
+extern ClusterPyramid g_clusters[MAP_MAX];
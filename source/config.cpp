@@ -0,0 +1,73 @@
+#include "config.h"
+#include "paths.h"
+#include "player.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+
+Config g_config;
+
+void makeDirs(const char* dir) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s", dir);
+    for (char* p = path + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(path, 0777);   // fails harmlessly for existing dirs and "sdmc:"
+        *p = '/';
+    }
+    mkdir(path, 0777);
+}
+
+static bool parseBool(const char* v) {
+    return !strcmp(v, "1") || !strcmp(v, "true") || !strcmp(v, "yes") || !strcmp(v, "on");
+}
+
+static SnapshotMode parseSnapshotMode(const char* v) {
+    if (!strcmp(v, "verified")) return SnapshotMode::Verified;
+    if (!strcmp(v, "paused"))   return SnapshotMode::Paused;
+    return SnapshotMode::Plain;
+}
+
+static char* trim(char* s) {
+    while (*s == ' ' || *s == '\t') s++;
+    char* e = s + strlen(s);
+    while (e > s && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r' || e[-1] == '\n')) *--e = '\0';
+    return s;
+}
+
+void loadConfig() {
+    FILE* f = fopen(DATA_ROOT "config.ini", "r");
+    if (!f) return;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char* eq = strchr(line, '=');
+        if (!eq) continue;
+        *eq = '\0';
+        const char* key = trim(line);
+        const char* val = trim(eq + 1);
+
+        if (!strcmp(key, "capture"))               g_config.capture = parseBool(val);
+        else if (!strcmp(key, "language"))         g_config.language = val;
+        else if (!strcmp(key, "map_labels"))       g_config.mapLabels = parseBool(val);
+        else if (!strcmp(key, "map_filter"))       g_config.mapFilter = val;
+        else if (!strcmp(key, "map_filter_hide"))  g_config.mapFilterHide = parseBool(val);
+        else if (!strcmp(key, "player_hz"))        g_config.playerHz = std::clamp(atoi(val), 0, PLAYER_MAX_HZ);
+        else if (!strcmp(key, "live_interval_ms")) g_config.liveIntervalMs = std::max(16, atoi(val));
+        else if (!strcmp(key, "snapshot_mode"))    g_config.snapshot.mode = parseSnapshotMode(val);
+        else if (!strcmp(key, "verify_retries"))   g_config.snapshot.retries = std::clamp(atoi(val), 0, 16);
+        else if (!strcmp(key, "verify_checksum"))  g_config.snapshot.checksum = parseBool(val);
+        else if (!strcmp(key, "autodetect"))       g_config.scan.enabled = parseBool(val);
+        else if (!strcmp(key, "offset_cache"))     g_config.scan.cache = parseBool(val);
+        else if (!strcmp(key, "stash_signature"))  g_config.scan.signature = val;
+        else if (!strcmp(key, "stash_signature_adrp")) g_config.scan.adrpOffset = std::max(0, atoi(val));
+        else if (!strcmp(key, "cheat_vm"))         g_config.snapshot.cheatVm = parseBool(val);
+        else if (!strcmp(key, "pause_budget_us"))  g_config.snapshot.pauseBudgetUs = std::max(50, atoi(val));
+    }
+    fclose(f);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <switch.h>
+
+#include <string>
+
+#include "sigscan.h"
+
+// ============================================================
+// Config (DATA_ROOT "config.ini")
+// ============================================================
+//
+// Plain "key = value" lines, '#' starts a comment. Unknown keys are
+// ignored so older builds accept newer files.
+
+enum class SnapshotMode {
+    Plain,      // single read per refresh
+    Verified,   // re-read until two reads agree, reject torn snapshots
+    Paused,     // pause the game around a single read
+};
+
+struct SnapshotOptions {
+    SnapshotMode mode = SnapshotMode::Plain;
+    int  retries  = 4;          // Verified: re-reads before a snapshot is rejected
+    bool checksum = true;       // Verified: changed slots must pass the PA9 checksum
+    int  pauseBudgetUs = 1000;  // Paused: longest acceptable pause before falling back
+    bool cheatVm  = false;      // resolve the pointer chain with a dmnt cheat
+};
+
+struct Config {
+    bool capture = false;       // record every dmnt:cht call to DATA_ROOT "captures/"
+    int  liveIntervalMs = 250;  // stash polling period in live mode
+    std::string language = "en";  // species name pack (species.h)
+    bool mapLabels = false;     // location labels on the map at startup
+    std::string mapFilter;      // custom map filter expression (filter.h)
+    bool mapFilterHide = false; // filtered-out spawners are hidden, not just dimmed
+    int  playerHz = 30;         // player position polling in live mode, 0 = off
+    SnapshotOptions snapshot;
+    ScanOptions     scan;       // base pointer detection for unknown builds
+};
+
+extern Config g_config;
+
+void loadConfig();
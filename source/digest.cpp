@@ -0,0 +1,57 @@
+#include "digest.h"
+
+#include <cstring>
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+static inline u32 crc64(u32 crc, u64 v) { return __crc32cd(crc, v); }
+static inline u32 crc8(u32 crc, u8 v)   { return __crc32cb(crc, v); }
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+static inline u32 crc64(u32 crc, u64 v) { return (u32)_mm_crc32_u64(crc, v); }
+static inline u32 crc8(u32 crc, u8 v)   { return _mm_crc32_u8(crc, v); }
+#else
+// Reflected CRC32C (Castagnoli) table, built at compile time
+struct Crc32cTable {
+    u32 t[256];
+    constexpr Crc32cTable() : t() {
+        for (u32 i = 0; i < 256; i++) {
+            u32 c = i;
+            for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0x82F63B78u & (0u - (c & 1)));
+            t[i] = c;
+        }
+    }
+};
+static constexpr Crc32cTable g_crcTable;
+
+static inline u32 crc8(u32 crc, u8 v) { return (crc >> 8) ^ g_crcTable.t[(crc ^ v) & 0xFF]; }
+static inline u32 crc64(u32 crc, u64 v) {
+    for (int i = 0; i < 8; i++) crc = crc8(crc, (u8)(v >> (i * 8)));
+    return crc;
+}
+#endif
+
+u64 digest64(const void* data, size_t len) {
+    const u8* p = (const u8*)data;
+    u32 a = 0xFFFFFFFFu;
+    u32 b = 0x9E3779B9u;   // different seed so equal lanes give different halves
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        u64 w0, w1;
+        memcpy(&w0, p + i, 8);
+        memcpy(&w1, p + i + 8, 8);
+        a = crc64(a, w0);
+        b = crc64(b, w1);
+    }
+    if (i + 8 <= len) {
+        u64 w;
+        memcpy(&w, p + i, 8);
+        a = crc64(a, w);
+        i += 8;
+    }
+    for (; i < len; i++) b = crc8(b, p[i]);
+
+    b = crc64(b, (u64)len);
+    return ((u64)~a << 32) | ~b;
+}
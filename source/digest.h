@@ -0,0 +1,14 @@
+#pragma once
+#include <switch.h>
+
+// ============================================================
+// Digest (change detection)
+// ============================================================
+//
+// 64-bit digest built from two interleaved CRC32C lanes (even and
+// odd 8-byte words), so both lanes keep the CRC unit busy. Uses
+// the ARMv8 CRC32 instructions on console (ARCH has +crc), SSE4.2
+// on the host when available, and a table fallback otherwise.
+// Not cryptographic: it only answers "did these bytes change?".
+
+u64 digest64(const void* data, size_t len);
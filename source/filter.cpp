@@ -0,0 +1,305 @@
+#include "filter.h"
+#include "search.h"
+
+#include <algorithm>
+#include <cstring>
+
+FilterIndex   g_filterIndex[MAP_MAX];
+SpawnerFilter g_filter;
+
+// ============================================================
+// Bitset
+// ============================================================
+
+void SpawnerBits::resize(u32 n) {
+    m_n = n;
+    m_words.assign((n + 63) / 64, 0);
+}
+
+void SpawnerBits::clear() {
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+void SpawnerBits::fill() {
+    std::fill(m_words.begin(), m_words.end(), ~0ULL);
+    if (m_n & 63) m_words.back() = (1ULL << (m_n & 63)) - 1;
+}
+
+void SpawnerBits::setRange(u32 begin, u32 end) {
+    if (begin >= end) return;
+    u32 w0 = begin >> 6, w1 = (end - 1) >> 6;
+    u64 head = ~0ULL << (begin & 63);
+    u64 tail = ~0ULL >> (63 - ((end - 1) & 63));
+    if (w0 == w1) {
+        m_words[w0] |= head & tail;
+        return;
+    }
+    m_words[w0] |= head;
+    for (u32 w = w0 + 1; w < w1; w++) m_words[w] = ~0ULL;
+    m_words[w1] |= tail;
+}
+
+void SpawnerBits::andWith(const SpawnerBits& o) {
+    for (size_t w = 0; w < m_words.size(); w++) m_words[w] &= o.m_words[w];
+}
+
+void SpawnerBits::orWith(const SpawnerBits& o) {
+    for (size_t w = 0; w < m_words.size(); w++) m_words[w] |= o.m_words[w];
+}
+
+void SpawnerBits::invert() {
+    for (u64& w : m_words) w = ~w;
+    if (m_n & 63) m_words.back() &= (1ULL << (m_n & 63)) - 1;
+}
+
+u32 SpawnerBits::count() const {
+    u32 n = 0;
+    for (u64 w : m_words) n += (u32)__builtin_popcountll(w);
+    return n;
+}
+
+// ============================================================
+// Index
+// ============================================================
+
+void FilterIndex::clear() {
+    m_spawner.clear();
+    m_texX.clear();
+    m_texZ.clear();
+    m_locations.clear();
+    m_byHash.clear();
+}
+
+void FilterIndex::build(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr) {
+    clear();
+    for (u32 i = 0; i < (u32)spawners.size(); i++)
+        if (spawners[i].mapIdx == mapIdx) m_spawner.push_back(i);
+    // Interned locations compare by pointer; any fixed order keeps them contiguous
+    std::sort(m_spawner.begin(), m_spawner.end(), [&](u32 a, u32 b) {
+        const SpawnerEntry& sa = spawners[a];
+        const SpawnerEntry& sb = spawners[b];
+        if (sa.location != sb.location) return std::less<const char*>()(sa.location, sb.location);
+        return sa.hash < sb.hash;
+    });
+
+    const u32 n = size();
+    m_texX.resize(n);
+    m_texZ.resize(n);
+    m_byHash.reserve(n);
+    for (u32 bit = 0; bit < n; bit++) {
+        const SpawnerEntry& sp = spawners[m_spawner[bit]];
+        m_texX[bit] = (float)tr.convertX(sp.x);
+        m_texZ[bit] = (float)tr.convertZ(sp.z);
+        m_byHash.push_back({sp.hash, bit});
+        if (m_locations.empty() || m_locations.back().name != sp.location)
+            m_locations.push_back({sp.location, foldSearchText(sp.location), bit, bit});
+        m_locations.back().end = bit + 1;
+    }
+    std::sort(m_byHash.begin(), m_byHash.end());
+}
+
+int FilterIndex::bitOf(u64 hash) const {
+    auto it = std::lower_bound(m_byHash.begin(), m_byHash.end(), std::make_pair(hash, 0u));
+    return it != m_byHash.end() && it->first == hash ? (int)it->second : -1;
+}
+
+// ============================================================
+// Parser
+// ============================================================
+//
+//   expr  := and ('|' and)*
+//   and   := unary ('&' unary)*
+//   unary := '!' unary | '(' expr ')' | term
+
+class SpawnerFilter::Parser {
+public:
+    Parser(const char* p, std::vector<Term>& terms, std::vector<Op>& prog)
+        : m_p(p), m_terms(terms), m_prog(prog) {}
+
+    const char* run() {
+        if (const char* err = expr()) return err;
+        skipSpace();
+        return *m_p ? "Unexpected text in filter" : nullptr;
+    }
+
+private:
+    void skipSpace() { while (*m_p == ' ' || *m_p == '\t') m_p++; }
+
+    const char* expr() {
+        if (const char* err = conj()) return err;
+        for (skipSpace(); *m_p == '|'; skipSpace()) {
+            m_p++;
+            if (const char* err = conj()) return err;
+            m_prog.push_back({Op::Or, -1});
+        }
+        return nullptr;
+    }
+
+    const char* conj() {
+        if (const char* err = unary()) return err;
+        for (skipSpace(); *m_p == '&'; skipSpace()) {
+            m_p++;
+            if (const char* err = unary()) return err;
+            m_prog.push_back({Op::And, -1});
+        }
+        return nullptr;
+    }
+
+    const char* unary() {
+        skipSpace();
+        if (*m_p == '!') {
+            m_p++;
+            if (const char* err = unary()) return err;
+            m_prog.push_back({Op::Not, -1});
+            return nullptr;
+        }
+        if (*m_p == '(') {
+            m_p++;
+            if (const char* err = expr()) return err;
+            skipSpace();
+            if (*m_p != ')') return "Missing ) in filter";
+            m_p++;
+            return nullptr;
+        }
+        return term();
+    }
+
+    // Quoted, or up to the next operator, trimmed
+    std::string argument(bool* quoted = nullptr) {
+        skipSpace();
+        const char* start = m_p;
+        if (quoted) *quoted = *m_p == '"';
+        if (*m_p == '"') {
+            start = ++m_p;
+            while (*m_p && *m_p != '"') m_p++;
+            std::string arg(start, m_p);
+            if (*m_p) m_p++;
+            return arg;
+        }
+        while (*m_p && !strchr("&|)", *m_p)) m_p++;
+        const char* end = m_p;
+        while (end > start && (end[-1] == ' ' || end[-1] == '\t')) end--;
+        return std::string(start, end);
+    }
+
+    const char* term() {
+        Term t;
+        if (!strncmp(m_p, "stash", 5)) {
+            m_p += 5;
+            t.kind = Term::Stash;
+        } else if (!strncmp(m_p, "map:", 4)) {
+            m_p += 4;
+            t.kind = Term::Map;
+            t.text = argument(&t.exact);
+        } else if (!strncmp(m_p, "loc:", 4)) {
+            m_p += 4;
+            t.kind = Term::Location;
+            t.text = argument(&t.exact);
+        } else if (!strncmp(m_p, "hash:", 5)) {
+            m_p += 5;
+            t.kind = Term::Hash;
+            std::string hex = argument();
+            size_t i = hex.compare(0, 2, "0x") == 0 ? 2 : 0;
+            t.digits = (int)(hex.size() - i);
+            if (t.digits < 1 || t.digits > 16) return "Hash prefix needs 1-16 hex digits";
+            for (; i < hex.size(); i++) {
+                char c = hex[i];
+                int v = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+                if (v < 0) return "Hash prefix needs 1-16 hex digits";
+                t.prefix = t.prefix << 4 | (u64)v;
+            }
+        } else {
+            return "Unknown filter term (stash, map:, loc: or hash:)";
+        }
+        m_prog.push_back({Op::Push, (int)m_terms.size()});
+        m_terms.push_back(std::move(t));
+        return nullptr;
+    }
+
+    const char*        m_p;
+    std::vector<Term>& m_terms;
+    std::vector<Op>&   m_prog;
+};
+
+const char* SpawnerFilter::parse(const std::string& expr) {
+    std::string folded = foldSearchText(expr.c_str());
+    if (folded.find_first_not_of(" \t") == std::string::npos) {
+        clear();
+        return nullptr;
+    }
+    std::vector<Term> terms;
+    std::vector<Op> prog;
+    if (const char* err = Parser(folded.c_str(), terms, prog).run()) return err;
+    m_text  = expr;
+    m_terms = std::move(terms);
+    m_prog  = std::move(prog);
+    return nullptr;
+}
+
+void SpawnerFilter::clear() {
+    m_text.clear();
+    m_terms.clear();
+    m_prog.clear();
+}
+
+// ============================================================
+// Evaluation
+// ============================================================
+
+static bool textMatches(const std::string& folded, const std::string& text, bool exact) {
+    return exact ? folded == text : folded.find(text) != std::string::npos;
+}
+
+void SpawnerFilter::compileTerm(const Term& t, const FilterIndex& idx, int mapIdx,
+                                const std::vector<u64>& stash, SpawnerBits& out) const {
+    out.resize(idx.size());
+    switch (t.kind) {
+        case Term::Stash:
+            for (u64 hash : stash) {
+                int bit = idx.bitOf(hash);
+                if (bit >= 0) out.set((u32)bit);
+            }
+            break;
+        case Term::Map:
+            if (mapIdx < (int)g_profile.maps.size() &&
+                textMatches(foldSearchText(g_profile.maps[mapIdx].name.c_str()), t.text, t.exact))
+                out.fill();
+            break;
+        case Term::Location:
+            for (const FilterIndex::Location& loc : idx.locations())
+                if (textMatches(loc.folded, t.text, t.exact)) out.setRange(loc.begin, loc.end);
+            break;
+        case Term::Hash: {
+            const int shift = 4 * (16 - t.digits);
+            u64 lo = t.prefix << shift;
+            u64 hi = lo | (shift ? (~0ULL >> (64 - shift)) : 0);
+            const auto& byHash = idx.byHash();
+            for (auto it = std::lower_bound(byHash.begin(), byHash.end(), std::make_pair(lo, 0u));
+                 it != byHash.end() && it->first <= hi; ++it)
+                out.set(it->second);
+            break;
+        }
+    }
+}
+
+void SpawnerFilter::evaluate(const FilterIndex& idx, int mapIdx, const std::vector<u64>& stash, SpawnerBits& out) {
+    if (m_prog.empty()) {
+        out.resize(idx.size());
+        out.fill();
+        return;
+    }
+    // Operands stay allocated in m_stack between calls
+    size_t top = 0;
+    for (const Op& op : m_prog) {
+        switch (op.kind) {
+            case Op::Push:
+                if (top == m_stack.size()) m_stack.emplace_back();
+                compileTerm(m_terms[op.term], idx, mapIdx, stash, m_stack[top++]);
+                break;
+            case Op::And: m_stack[top - 2].andWith(m_stack[top - 1]); top--; break;
+            case Op::Or:  m_stack[top - 2].orWith(m_stack[top - 1]);  top--; break;
+            case Op::Not: m_stack[top - 1].invert(); break;
+        }
+    }
+    std::swap(out, m_stack[0]);
+}
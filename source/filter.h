@@ -0,0 +1,125 @@
+#pragma once
+#include <switch.h>
+
+#include <string>
+#include <vector>
+
+#include "profile.h"
+#include "spawners.h"
+
+// ============================================================
+// Spawner Filters
+// ============================================================
+//
+// A filter is a boolean expression over the spawners of one map:
+//
+//   stash            spawners that hold a stash entry
+//   map:<name>       every spawner of the maps whose name contains <name>
+//   loc:<text>       location contains <text>
+//   hash:<hex>       hash starts with the hex digits (1-16, optional 0x)
+//
+// joined with & (and), | (or), ! (not) and parentheses, for example
+// "loc:wild zone | stash & !hash:46". An argument runs up to the next
+// &, | or ); a quoted one must match the whole name instead of a part
+// (loc:"Wild Zone 1" leaves out Wild Zone 10). Text is compared
+// ignoring case and Latin-1 accents.
+//
+// Each map's spawners get a stable bit order (location, then hash), so
+// a location is one contiguous bit range and a hash prefix a range of
+// a hash-sorted table. Terms compile to bitsets in O(words + matches)
+// and the expression is combined 64 spawners per operation; drawing
+// then walks the set bits instead of testing every point.
+
+class SpawnerBits {
+public:
+    void resize(u32 n);                 // n bits, all clear
+    u32  size() const { return m_n; }
+    void clear();
+    void fill();
+    void set(u32 i)           { m_words[i >> 6] |= 1ULL << (i & 63); }
+    bool test(u32 i) const    { return (m_words[i >> 6] >> (i & 63)) & 1; }
+    void setRange(u32 begin, u32 end);
+
+    void andWith(const SpawnerBits& o);
+    void orWith(const SpawnerBits& o);
+    void invert();
+    u32  count() const;
+
+    template <typename F>
+    void forEach(F&& f) const {
+        for (u32 w = 0; w < (u32)m_words.size(); w++)
+            for (u64 bits = m_words[w]; bits; bits &= bits - 1)
+                f((w << 6) | (u32)__builtin_ctzll(bits));
+    }
+
+private:
+    u32 m_n = 0;
+    std::vector<u64> m_words;
+};
+
+// One map's spawners in filter bit order
+class FilterIndex {
+public:
+    struct Location {
+        const char* name;
+        std::string folded;
+        u32 begin, end;   // bit range
+    };
+
+    void build(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr);
+    void clear();
+
+    u32   size() const          { return (u32)m_spawner.size(); }
+    u32   spawner(u32 bit) const { return m_spawner[bit]; }   // index into the built vector
+    float texX(u32 bit) const   { return m_texX[bit]; }
+    float texZ(u32 bit) const   { return m_texZ[bit]; }
+    int   bitOf(u64 hash) const;                              // -1 if not on this map
+
+    const std::vector<Location>& locations() const { return m_locations; }
+    const std::vector<std::pair<u64, u32>>& byHash() const { return m_byHash; }   // (hash, bit), sorted
+
+private:
+    std::vector<u32>      m_spawner;
+    std::vector<float>    m_texX, m_texZ;
+    std::vector<Location> m_locations;
+    std::vector<std::pair<u64, u32>> m_byHash;
+};
+
+class SpawnerFilter {
+public:
+    // nullptr on success, otherwise why `expr` does not parse (the
+    // previous filter is kept). An empty expression clears the filter.
+    const char* parse(const std::string& expr);
+    void clear();
+    bool active() const              { return !m_prog.empty(); }
+    const std::string& text() const  { return m_text; }
+
+    // Spawners of `mapIdx` that pass, in idx's bit order. `stash` are the
+    // hashes of the current stash entries.
+    void evaluate(const FilterIndex& idx, int mapIdx, const std::vector<u64>& stash, SpawnerBits& out);
+
+private:
+    struct Term {
+        enum Kind : u8 { Stash, Map, Location, Hash } kind;
+        std::string text;   // folded
+        bool exact = false; // quoted: whole name
+        u64 prefix = 0;
+        int digits = 0;
+    };
+    struct Op {
+        enum Kind : u8 { Push, And, Or, Not } kind;
+        int term;
+    };
+    class Parser;
+
+    void compileTerm(const Term& t, const FilterIndex& idx, int mapIdx,
+                     const std::vector<u64>& stash, SpawnerBits& out) const;
+
+    std::string       m_text;
+    std::vector<Term> m_terms;
+    std::vector<Op>   m_prog;    // postfix
+    std::vector<SpawnerBits> m_stack;
+};
+
+extern FilterIndex   g_filterIndex[MAP_MAX];
+extern SpawnerFilter g_filter;
@@ -0,0 +1,194 @@
+#include "heatmap.h"
+#include "timing.h"
+#include "workers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+static HeatmapImage      g_heatImages[MAP_MAX];
+static std::atomic<bool> g_heatReady{false};
+static std::thread       g_heatWorker;
+
+int heatmapThreads() {
+    return workerCores();
+}
+
+// Runs fn(band, r0, r1) over `threads` bands of [0, rows), the calling
+// thread taking band 0, and returns once all are done. Band t runs on
+// core t, so the bands are spread over the cores.
+template <typename F>
+static void parallelRows(int rows, int threads, F&& fn) {
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back([&fn, t, rows, threads] {
+            pinToCore(t);
+            fn(t, rows * t / threads, rows * (t + 1) / threads);
+        });
+    fn(0, 0, rows / threads);
+    for (auto& th : pool) th.join();
+}
+
+// Box filter of radius r along one line, zero outside
+static void boxLine(const float* in, float* out, int n, int r) {
+    const float inv = 1.0f / (float)(2 * r + 1);
+    float sum = 0;
+    for (int i = 0; i < std::min(r, n); i++) sum += in[i];
+    for (int i = 0; i < n; i++) {
+        if (i + r < n)      sum += in[i + r];
+        out[i] = sum * inv;
+        if (i - r >= 0)     sum -= in[i - r];
+    }
+}
+
+// Vertical box filter of radius r for rows [r0, r1), zero outside
+static void boxColumns(const float* in, float* out, int w, int h, int r, int r0, int r1) {
+    const float inv = 1.0f / (float)(2 * r + 1);
+    std::vector<float> sum(w, 0.0f);
+    for (int y = std::max(0, r0 - r); y < std::min(h, r0 + r); y++) {
+        const float* row = in + (size_t)y * w;
+        for (int x = 0; x < w; x++) sum[x] += row[x];
+    }
+    for (int y = r0; y < r1; y++) {
+        if (y + r < h) {
+            const float* add = in + (size_t)(y + r) * w;
+            for (int x = 0; x < w; x++) sum[x] += add[x];
+        }
+        float* dst = out + (size_t)y * w;
+        for (int x = 0; x < w; x++) dst[x] = sum[x] * inv;
+        if (y - r >= 0) {
+            const float* sub = in + (size_t)(y - r) * w;
+            for (int x = 0; x < w; x++) sum[x] -= sub[x];
+        }
+    }
+}
+
+// Transparent through blue, cyan and yellow to red, by sqrt(density)
+static void buildRamp(u32* lut) {
+    static const float stops[4][3] = {{0, 0, 255}, {0, 255, 255}, {255, 255, 0}, {255, 0, 0}};
+    for (int i = 0; i < 256; i++) {
+        float t = i / 255.0f;
+        float s = std::min(t * 3.0f, 2.999f);
+        int k = (int)s;
+        float f = s - k;
+        u32 c[3];
+        for (int j = 0; j < 3; j++) c[j] = (u32)(stops[k][j] + (stops[k + 1][j] - stops[k][j]) * f);
+        u32 a = (u32)(std::min(1.0f, t * 4.0f) * 0xB0);
+        lut[i] = i ? (a << 24) | (c[0] << 16) | (c[1] << 8) | c[2] : 0;
+    }
+}
+
+void computeHeatmap(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr,
+                    int w, int h, int threads, std::vector<u32>& argb, HeatmapTiming* timing) {
+    threads = std::clamp(threads, 1, std::max(1, h));
+    argb.resize((size_t)w * h);
+    u64 t0 = nowNs();
+
+    // Bin spawners by row so each band splats only its own rows
+    std::vector<u32> rowStart(h + 1, 0);
+    std::vector<int> px;
+    std::vector<std::pair<int, int>> pts;
+    for (const auto& sp : spawners) {
+        if (sp.mapIdx != mapIdx) continue;
+        int x = (int)(tr.convertX(sp.x) * w / tr.texW);
+        int y = (int)(tr.convertZ(sp.z) * h / tr.texH);
+        if (x < 0 || x >= w || y < 0 || y >= h) continue;
+        pts.push_back({x, y});
+        rowStart[y + 1]++;
+    }
+    for (int y = 1; y <= h; y++) rowStart[y] += rowStart[y - 1];
+    px.resize(pts.size());
+    {
+        std::vector<u32> fill(rowStart.begin(), rowStart.end() - 1);
+        for (const auto& p : pts) px[fill[p.second]++] = p.first;
+    }
+
+    // Left uninitialised: every stage writes its whole band first
+    std::unique_ptr<float[]> a(new float[(size_t)w * h]), b(new float[(size_t)w * h]);
+    const float sigma = HEAT_SIGMA * std::max(w, h);
+    const int r = std::max(1, (int)std::lround((std::sqrt(4.0f * sigma * sigma + 1.0f) - 1.0f) / 2.0f));
+
+    parallelRows(h, threads, [&](int, int r0, int r1) {
+        std::fill(a.get() + (size_t)r0 * w, a.get() + (size_t)r1 * w, 0.0f);
+        for (int y = r0; y < r1; y++)
+            for (u32 k = rowStart[y]; k < rowStart[y + 1]; k++) a[(size_t)y * w + px[k]] += 1.0f;
+    });
+    u64 t1 = nowNs();
+
+    // Three box passes per axis ~ Gaussian
+    parallelRows(h, threads, [&](int, int r0, int r1) {
+        std::vector<float> tmp(w);
+        for (int y = r0; y < r1; y++) {
+            float* row = &a[(size_t)y * w];
+            boxLine(row, tmp.data(), w, r);
+            boxLine(tmp.data(), &b[(size_t)y * w], w, r);
+            boxLine(&b[(size_t)y * w], row, w, r);
+        }
+    });
+    parallelRows(h, threads, [&](int, int r0, int r1) { boxColumns(a.get(), b.get(), w, h, r, r0, r1); });
+    parallelRows(h, threads, [&](int, int r0, int r1) { boxColumns(b.get(), a.get(), w, h, r, r0, r1); });
+    std::vector<float> bandMax(threads, 0.0f);
+    parallelRows(h, threads, [&](int t, int r0, int r1) {
+        boxColumns(a.get(), b.get(), w, h, r, r0, r1);
+        float m = 0;
+        for (size_t i = (size_t)r0 * w; i < (size_t)r1 * w; i++) m = std::max(m, b[i]);
+        bandMax[t] = m;
+    });
+    u64 t2 = nowNs();
+
+    float peak = *std::max_element(bandMax.begin(), bandMax.end());
+    {
+        u32 lut[256];
+        buildRamp(lut);
+        const float scale = peak > 0 ? 1.0f / peak : 0.0f;
+        parallelRows(h, threads, [&](int, int r0, int r1) {
+            for (size_t i = (size_t)r0 * w; i < (size_t)r1 * w; i++) {
+                float t = std::max(0.0f, b[i] * scale);
+                argb[i] = lut[std::min(255, (int)(std::sqrt(t) * 255.0f))];
+            }
+        });
+    }
+    u64 t3 = nowNs();
+    if (timing) *timing = {t1 - t0, t2 - t1, t3 - t2};
+}
+
+// ============================================================
+// Background Build
+// ============================================================
+
+void startHeatmapBuild() {
+    stopHeatmapBuild();
+    g_heatReady = false;
+    g_heatWorker = std::thread([] {
+        pinToCore(0);   // band 0 of every parallelRows() call
+        for (int m = 0; m < MAP_MAX; m++) {
+            HeatmapImage& img = g_heatImages[m];
+            img = HeatmapImage();
+            if (m >= (int)g_profile.maps.size()) continue;
+            const MapTransform& tr = g_profile.maps[m].transform;
+            double fit = std::min(1.0, HEAT_MAX_DIM / std::max(tr.texW, tr.texH));
+            img.w = std::max(1, (int)(tr.texW * fit));
+            img.h = std::max(1, (int)(tr.texH * fit));
+            computeHeatmap(g_spawners, m, tr, img.w, img.h, heatmapThreads(), img.argb);
+        }
+        g_heatReady = true;
+    });
+}
+
+void stopHeatmapBuild() {
+    if (g_heatWorker.joinable()) g_heatWorker.join();
+}
+
+bool heatmapReady() {
+    return g_heatReady;
+}
+
+bool takeHeatmap(int mapIdx, HeatmapImage& out) {
+    if (!g_heatReady || g_heatImages[mapIdx].argb.empty()) return false;
+    out = std::move(g_heatImages[mapIdx]);
+    g_heatImages[mapIdx] = HeatmapImage();
+    return true;
+}
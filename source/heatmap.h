@@ -0,0 +1,48 @@
+#pragma once
+#include <switch.h>
+
+#include <vector>
+
+#include "profile.h"
+#include "spawners.h"
+
+// ============================================================
+// Density Heatmap
+// ============================================================
+//
+// Kernel density of one map's spawners, as an ARGB8888 image covering
+// the whole map texture at w x h. Spawners are binned to pixels, then
+// blurred with three box passes per axis, which approximates a Gaussian
+// of HEAT_SIGMA (times the larger side) at a cost independent of the
+// kernel size. Every stage runs on `threads` workers, each owning a
+// band of rows; stages are separated by joins.
+//
+// startHeatmapBuild() computes every map at the app's size on a worker
+// thread when the data loads, so the render thread only uploads the
+// finished image the first time a map's heatmap is drawn.
+
+static constexpr int   HEAT_MAX_DIM = 1024;          // image size used by the app
+static constexpr float HEAT_SIGMA   = 1.0f / 150.0f;
+
+struct HeatmapTiming {
+    u64 splatNs;
+    u64 blurNs;
+    u64 colorNs;
+};
+
+int heatmapThreads();   // workerCores(): the cores the app may use
+
+void computeHeatmap(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr,
+                    int w, int h, int threads, std::vector<u32>& argb, HeatmapTiming* timing = nullptr);
+
+struct HeatmapImage {
+    int w = 0, h = 0;
+    std::vector<u32> argb;
+};
+
+void startHeatmapBuild();   // over g_spawners; call after they are loaded
+void stopHeatmapBuild();    // waits for the worker
+bool heatmapReady();
+// Moves a map's finished image into `out`; false until heatmapReady()
+// and after the image was taken.
+bool takeHeatmap(int mapIdx, HeatmapImage& out);
@@ -0,0 +1,85 @@
+#include "labels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+LabelLayer g_labels[MAP_MAX];
+
+void LabelLayer::clear() {
+    m_anchors.clear();
+    m_layouts.clear();
+}
+
+void LabelLayer::build(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr) {
+    clear();
+    // Location names are interned, so the pointer identifies the place
+    struct Sum { double x = 0, z = 0; u32 n = 0; };
+    std::unordered_map<const char*, Sum> sums;
+    for (const auto& sp : spawners) {
+        if (sp.mapIdx != mapIdx || !sp.location || !sp.location[0]) continue;
+        double tx = tr.convertX(sp.x), tz = tr.convertZ(sp.z);
+        if (tx < 0 || tx >= tr.texW || tz < 0 || tz >= tr.texH) continue;
+        Sum& s = sums[sp.location];
+        s.x += tx;
+        s.z += tz;
+        s.n++;
+    }
+    m_anchors.reserve(sums.size());
+    for (const auto& [name, s] : sums)
+        m_anchors.push_back({name, (float)(s.x / s.n), (float)(s.z / s.n), s.n});
+    // Ties by position so the layout does not depend on hash order
+    std::sort(m_anchors.begin(), m_anchors.end(), [](const LabelAnchor& a, const LabelAnchor& b) {
+        if (a.spawners != b.spawners) return a.spawners > b.spawners;
+        return a.texZ != b.texZ ? a.texZ < b.texZ : a.texX < b.texX;
+    });
+}
+
+const std::vector<PlacedLabel>& LabelLayer::layout(float scale, double texW, double texH) {
+    for (const Layout& l : m_layouts)
+        if (l.scale == scale) return l.labels;
+
+    Layout& out = m_layouts.emplace_back();
+    out.scale = scale;
+    int mapW = (int)(texW * scale), mapH = (int)(texH * scale);
+
+    std::unordered_map<u64, std::vector<int>> buckets;   // bucket -> indices into out.labels
+    auto bucketKey = [](int bx, int by) { return ((u64)(u32)by << 32) | (u32)bx; };
+    auto overlaps = [&](const PlacedLabel& p, const LabelAnchor& a) {
+        int x0 = p.x - LABEL_PAD, y0 = p.y - LABEL_PAD;
+        int x1 = p.x + a.w + LABEL_PAD, y1 = p.y + a.h + LABEL_PAD;
+        for (int by = y0 / LABEL_HASH_CELL; by <= y1 / LABEL_HASH_CELL; by++) {
+            for (int bx = x0 / LABEL_HASH_CELL; bx <= x1 / LABEL_HASH_CELL; bx++) {
+                auto it = buckets.find(bucketKey(bx, by));
+                if (it == buckets.end()) continue;
+                for (int i : it->second) {
+                    const PlacedLabel& q = out.labels[i];
+                    const LabelAnchor& b = m_anchors[q.anchor];
+                    if (x0 < q.x + b.w && q.x < x1 && y0 < q.y + b.h && q.y < y1) return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    for (int ai = 0; ai < (int)m_anchors.size(); ai++) {
+        const LabelAnchor& a = m_anchors[ai];
+        if (a.w <= 0 || a.w > mapW || a.h > mapH) continue;
+        int ax = (int)(a.texX * scale), ay = (int)(a.texZ * scale);
+
+        // Centred on the anchor, else just above or below it
+        const int dy[] = {-a.h / 2, -a.h - LABEL_PAD, LABEL_PAD};
+        for (int d : dy) {
+            PlacedLabel p = {ai, std::clamp(ax - a.w / 2, 0, mapW - a.w), std::clamp(ay + d, 0, mapH - a.h)};
+            if (overlaps(p, a)) continue;
+            int idx = (int)out.labels.size();
+            out.labels.push_back(p);
+            for (int by = p.y / LABEL_HASH_CELL; by <= (p.y + a.h) / LABEL_HASH_CELL; by++)
+                for (int bx = p.x / LABEL_HASH_CELL; bx <= (p.x + a.w) / LABEL_HASH_CELL; bx++)
+                    buckets[bucketKey(bx, by)].push_back(idx);
+            break;
+        }
+    }
+    return out.labels;
+}
+
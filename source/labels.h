@@ -0,0 +1,60 @@
+#pragma once
+#include <switch.h>
+
+#include <vector>
+
+#include "profile.h"
+#include "spawners.h"
+
+// ============================================================
+// Location Labels
+// ============================================================
+//
+// One label per distinct SpawnerEntry::location on a map, anchored at
+// the centroid of its spawners. layout() places labels greedily, most
+// spawners first, and drops any that would overlap one already placed;
+// a spatial hash of LABEL_HASH_CELL-pixel buckets keeps each test local.
+//
+// Layouts are made for the whole map at a given scale, in "map pixels"
+// (texture pixels times scale), so panning only shifts them. Each scale
+// is laid out once and kept, which leaves the per-frame cost at culling
+// the cached labels against the view.
+
+static constexpr int LABEL_HASH_CELL = 64;
+static constexpr int LABEL_PAD       = 8;   // min gap between labels, room for their backing
+
+struct LabelAnchor {
+    const char* name;
+    float texX, texZ;   // centroid
+    u32   spawners;
+    int   w = 0, h = 0; // text size in screen pixels, set by the renderer
+};
+
+struct PlacedLabel {
+    int anchor;
+    int x, y;           // top-left, in map pixels
+};
+
+class LabelLayer {
+public:
+    void build(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr);
+    void clear();
+
+    // Text sizes may be changed after dropLayouts()
+    std::vector<LabelAnchor>& anchors() { return m_anchors; }
+    void dropLayouts() { m_layouts.clear(); }
+
+    // Labels for `scale` screen pixels per texture pixel on a texW x texH
+    // map; computed on first use and cached until clear() or build().
+    const std::vector<PlacedLabel>& layout(float scale, double texW, double texH);
+
+private:
+    struct Layout {
+        float scale;
+        std::vector<PlacedLabel> labels;
+    };
+    std::vector<LabelAnchor> m_anchors;   // most spawners first
+    std::vector<Layout>      m_layouts;
+};
+
+extern LabelLayer g_labels[MAP_MAX];
@@ -0,0 +1,132 @@
+#include "memcapture.h"
+#include "paths.h"
+#include "timing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+static constexpr size_t CAPTURE_BUFFER = 64 * 1024;
+
+CaptureMemorySource::CaptureMemorySource(MemorySource* inner, FILE* file)
+    : m_inner(inner), m_file(file), m_startNs(nowNs()) {
+    setvbuf(m_file, nullptr, _IOFBF, CAPTURE_BUFFER);
+    fwrite(CAPTURE_MAGIC, 1, sizeof(CAPTURE_MAGIC), m_file);
+}
+
+CaptureMemorySource::~CaptureMemorySource() {
+    fclose(m_file);
+    delete m_inner;
+}
+
+void CaptureMemorySource::append(CaptureOp op, Result rc, u64 t0, u64 t1, u32 size, u64 address,
+                                 const void* payload, u32 payloadSize) {
+    CaptureRecord rec = {};
+    rec.op         = op;
+    rec.result     = rc;
+    rec.startNs    = t0 - m_startNs;
+    rec.durationNs = (u32)std::min<u64>(t1 - t0, 0xFFFFFFFFu);
+    rec.size       = size;
+    rec.address    = address;
+    fwrite(&rec, sizeof(rec), 1, m_file);
+    if (payloadSize) fwrite(payload, 1, payloadSize, m_file);
+}
+
+const char* CaptureMemorySource::open() {
+    u64 t0 = nowNs();
+    const char* err = m_inner->open();
+    u64 t1 = nowNs();
+    u32 len = err ? (u32)strlen(err) : 0;
+    append(CAP_OPEN, err ? 1 : 0, t0, t1, len, 0, err, len);
+    return err;
+}
+
+void CaptureMemorySource::close() {
+    u64 t0 = nowNs();
+    m_inner->close();
+    append(CAP_CLOSE, 0, t0, nowNs(), 0, 0, nullptr, 0);
+    fflush(m_file);   // one flush per refresh keeps SD writes batched
+}
+
+Result CaptureMemorySource::getMetadata(DmntCheatProcessMetadata* out) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->getMetadata(out);
+    u64 t1 = nowNs();
+    u32 size = R_SUCCEEDED(rc) ? (u32)sizeof(*out) : 0;
+    append(CAP_METADATA, rc, t0, t1, size, 0, out, size);
+    return rc;
+}
+
+Result CaptureMemorySource::read(u64 address, void* buffer, size_t size) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->read(address, buffer, size);
+    u64 t1 = nowNs();
+    append(CAP_READ, rc, t0, t1, (u32)size, address, buffer, R_SUCCEEDED(rc) ? (u32)size : 0);
+    return rc;
+}
+
+Result CaptureMemorySource::queryMemory(u64 address, MemoryInfo* out) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->queryMemory(address, out);
+    u64 t1 = nowNs();
+    u32 size = R_SUCCEEDED(rc) ? (u32)sizeof(*out) : 0;
+    append(CAP_QUERY, rc, t0, t1, size, address, out, size);
+    return rc;
+}
+
+Result CaptureMemorySource::pause() {
+    u64 t0 = nowNs();
+    Result rc = m_inner->pause();
+    append(CAP_PAUSE, rc, t0, nowNs(), 0, 0, nullptr, 0);
+    return rc;
+}
+
+Result CaptureMemorySource::resume() {
+    u64 t0 = nowNs();
+    Result rc = m_inner->resume();
+    append(CAP_RESUME, rc, t0, nowNs(), 0, 0, nullptr, 0);
+    return rc;
+}
+
+Result CaptureMemorySource::addCheat(const DmntCheatDefinition& def, u32* outId) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->addCheat(def, outId);
+    u32 size = R_SUCCEEDED(rc) ? (u32)sizeof(*outId) : 0;
+    append(CAP_ADD_CHEAT, rc, t0, nowNs(), size, 0, outId, size);
+    return rc;
+}
+
+Result CaptureMemorySource::removeCheat(u32 id) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->removeCheat(id);
+    append(CAP_REMOVE_CHEAT, rc, t0, nowNs(), 0, id, nullptr, 0);
+    return rc;
+}
+
+Result CaptureMemorySource::readStaticRegister(u8 which, u64* out) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->readStaticRegister(which, out);
+    u32 size = R_SUCCEEDED(rc) ? (u32)sizeof(*out) : 0;
+    append(CAP_STATIC_READ, rc, t0, nowNs(), size, which, out, size);
+    return rc;
+}
+
+Result CaptureMemorySource::writeStaticRegister(u8 which, u64 value) {
+    u64 t0 = nowNs();
+    Result rc = m_inner->writeStaticRegister(which, value);
+    append(CAP_STATIC_WRITE, rc, t0, nowNs(), 0, which, nullptr, 0);
+    return rc;
+}
+
+MemorySource* startCapture(MemorySource* inner, const char* path) {
+    char defPath[256];
+    if (!path) {
+        makeDirs(DATA_ROOT "captures");
+        time_t t = time(nullptr);
+        strftime(defPath, sizeof(defPath), DATA_ROOT "captures/%Y%m%d-%H%M%S.sslmcap", localtime(&t));
+        path = defPath;
+    }
+    FILE* f = fopen(path, "wb");
+    if (!f) return inner;
+    return new CaptureMemorySource(inner, f);
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "memsource.h"
+
+#include <cstdio>
+
+// ============================================================
+// Memory Capture
+// ============================================================
+//
+// Decorator that forwards every call to an inner MemorySource and
+// appends the call and its response to a binary log, so a live
+// session can be replayed deterministically (host --replay).
+//
+// Log format (little endian):
+//   "SSLMCAP1"
+//   repeated: CaptureRecord, then payload bytes
+//     CAP_OPEN      payload = status message when result != 0
+//     CAP_METADATA  payload = DmntCheatProcessMetadata when result == 0
+//     CAP_READ      payload = `size` bytes read when result == 0
+//     CAP_ADD_CHEAT payload = u32 cheat id when result == 0
+//     CAP_STATIC_READ  address = register, payload = u64 value when result == 0
+//     CAP_STATIC_WRITE / CAP_REMOVE_CHEAT  address = register / cheat id
+//     CAP_QUERY     address = queried address, payload = MemoryInfo when result == 0
+
+static constexpr char CAPTURE_MAGIC[8] = {'S','S','L','M','C','A','P','1'};
+
+enum CaptureOp : u8 {
+    CAP_OPEN     = 1,
+    CAP_CLOSE    = 2,
+    CAP_METADATA = 3,
+    CAP_READ     = 4,
+    CAP_PAUSE    = 5,
+    CAP_RESUME   = 6,
+    CAP_ADD_CHEAT    = 7,
+    CAP_REMOVE_CHEAT = 8,
+    CAP_STATIC_READ  = 9,
+    CAP_STATIC_WRITE = 10,
+    CAP_QUERY        = 11,
+};
+
+struct CaptureRecord {
+    u8  op;
+    u8  reserved[3];
+    u32 result;
+    u64 startNs;        // since the capture started
+    u32 durationNs;     // time spent in the inner call
+    u32 size;           // requested size (CAP_READ) or payload size
+    u64 address;        // CAP_READ, or the register / cheat id
+};
+static_assert(sizeof(CaptureRecord) == 32, "CaptureRecord layout");
+
+class CaptureMemorySource : public MemorySource {
+public:
+    // Takes ownership of both `inner` and `file`.
+    CaptureMemorySource(MemorySource* inner, FILE* file);
+    ~CaptureMemorySource() override;
+
+    const char* open() override;
+    void close() override;
+    Result getMetadata(DmntCheatProcessMetadata* out) override;
+    Result read(u64 address, void* buffer, size_t size) override;
+    Result queryMemory(u64 address, MemoryInfo* out) override;
+    Result pause() override;
+    Result resume() override;
+    Result addCheat(const DmntCheatDefinition& def, u32* outId) override;
+    Result removeCheat(u32 id) override;
+    Result readStaticRegister(u8 which, u64* out) override;
+    Result writeStaticRegister(u8 which, u64 value) override;
+
+private:
+    void append(CaptureOp op, Result rc, u64 t0, u64 t1, u32 size, u64 address,
+                const void* payload, u32 payloadSize);
+
+    MemorySource* m_inner;
+    FILE*         m_file;
+    u64           m_startNs;
+};
+
+// Wraps `inner` with a capture to `path`, or to
+// DATA_ROOT "captures/<timestamp>.sslmcap" when path is null.
+// Returns `inner` unchanged if the log cannot be created.
+MemorySource* startCapture(MemorySource* inner, const char* path = nullptr);
@@ -0,0 +1,87 @@
+#pragma once
+#include <switch.h>
+#include <switch/dmntcht.h>
+
+#include <mutex>
+
+// ============================================================
+// Memory Source
+// ============================================================
+//
+// Everything that touches the game process goes through this
+// interface. On console it wraps dmnt:cht; the host build plugs
+// in backends that replay a memory dump or synthesize a stash.
+
+class MemorySource {
+public:
+    virtual ~MemorySource() = default;
+
+    // Attach to the cheat process. Returns nullptr on success,
+    // otherwise a status message for the UI.
+    virtual const char* open() = 0;
+    virtual void close() = 0;
+
+    virtual Result getMetadata(DmntCheatProcessMetadata* out) = 0;
+    virtual Result read(u64 address, void* buffer, size_t size) = 0;
+    virtual Result queryMemory(u64 address, MemoryInfo* out) = 0;
+
+    // Suspend / resume the game's threads around a consistent read.
+    virtual Result pause() = 0;
+    virtual Result resume() = 0;
+
+    // Cheat VM: install/remove a program and access static registers.
+    virtual Result addCheat(const DmntCheatDefinition& def, u32* outId) = 0;
+    virtual Result removeCheat(u32 id) = 0;
+    virtual Result readStaticRegister(u8 which, u64* out) = 0;
+    virtual Result writeStaticRegister(u8 which, u64 value) = 0;
+};
+
+// Implemented once per platform (memsource_dmnt.cpp / host/memsource_host.cpp)
+MemorySource* createMemorySource(int argc, char* argv[]);
+
+// Serializes every call to `inner` (owned) so several threads can share
+// one session; used once a background reader runs next to the app's.
+class SharedMemorySource : public MemorySource {
+public:
+    explicit SharedMemorySource(MemorySource* inner) : m_inner(inner) {}
+    ~SharedMemorySource() override { delete m_inner; }
+
+    const char* open() override { std::lock_guard<std::mutex> l(m_mutex); return m_inner->open(); }
+    void close() override       { std::lock_guard<std::mutex> l(m_mutex); m_inner->close(); }
+
+    Result getMetadata(DmntCheatProcessMetadata* out) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->getMetadata(out);
+    }
+    Result read(u64 address, void* buffer, size_t size) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->read(address, buffer, size);
+    }
+    Result queryMemory(u64 address, MemoryInfo* out) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->queryMemory(address, out);
+    }
+    Result pause() override  { std::lock_guard<std::mutex> l(m_mutex); return m_inner->pause(); }
+    Result resume() override { std::lock_guard<std::mutex> l(m_mutex); return m_inner->resume(); }
+
+    Result addCheat(const DmntCheatDefinition& def, u32* outId) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->addCheat(def, outId);
+    }
+    Result removeCheat(u32 id) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->removeCheat(id);
+    }
+    Result readStaticRegister(u8 which, u64* out) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->readStaticRegister(which, out);
+    }
+    Result writeStaticRegister(u8 which, u64 value) override {
+        std::lock_guard<std::mutex> l(m_mutex);
+        return m_inner->writeStaticRegister(which, value);
+    }
+
+private:
+    MemorySource* m_inner;
+    std::mutex    m_mutex;
+};
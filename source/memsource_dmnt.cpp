@@ -0,0 +1,65 @@
+#include "memsource.h"
+
+// ============================================================
+// dmnt:cht Memory Source
+// ============================================================
+
+class DmntMemorySource : public MemorySource {
+public:
+    const char* open() override {
+        Result rc = dmntchtInitialize();
+        if (R_FAILED(rc)) return "dmntcht init failed";
+
+        bool hasProc = false;
+        rc = dmntchtHasCheatProcess(&hasProc);
+        if (R_FAILED(rc) || !hasProc) {
+            dmntchtExit();
+            return "No cheat process (is Atmosphere running?)";
+        }
+
+        rc = dmntchtForceOpenCheatProcess();
+        if (R_FAILED(rc)) {
+            dmntchtExit();
+            return "Can't open cheat process";
+        }
+        return nullptr;
+    }
+
+    void close() override {
+        dmntchtExit();
+    }
+
+    Result getMetadata(DmntCheatProcessMetadata* out) override {
+        return dmntchtGetCheatProcessMetadata(out);
+    }
+
+    Result read(u64 address, void* buffer, size_t size) override {
+        return dmntchtReadCheatProcessMemory(address, buffer, size);
+    }
+
+    Result queryMemory(u64 address, MemoryInfo* out) override {
+        return dmntchtQueryCheatProcessMemory(out, address);
+    }
+
+    Result pause() override  { return dmntchtPauseCheatProcess(); }
+    Result resume() override { return dmntchtResumeCheatProcess(); }
+
+    Result addCheat(const DmntCheatDefinition& def, u32* outId) override {
+        DmntCheatDefinition copy = def;   // libnx takes a non-const pointer
+        return dmntchtAddCheat(&copy, true, outId);
+    }
+
+    Result removeCheat(u32 id) override { return dmntchtRemoveCheat(id); }
+
+    Result readStaticRegister(u8 which, u64* out) override {
+        return dmntchtReadStaticRegister(out, which);
+    }
+
+    Result writeStaticRegister(u8 which, u64 value) override {
+        return dmntchtWriteStaticRegister(which, value);
+    }
+};
+
+MemorySource* createMemorySource(int, char*[]) {
+    return new DmntMemorySource();
+}
@@ -0,0 +1,367 @@
+#include "namehash.h"
+#include "paths.h"
+#include "stash.h"
+#include "workers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+static_assert(SPAWNER_HASH_BASIS == TERMINATOR_HASH, "the stash terminator is the empty name's hash");
+
+NameTemplates     g_nameTemplates;
+SpawnerNameLookup g_spawnerNames;
+
+static constexpr int RANGE_MAX_WIDTH = 4;     // wider last fields use the values seen
+static constexpr int NAME_FIELDS_MAX = 16;
+static constexpr u64 SEARCH_CHUNK    = 16;    // blocks a worker takes at a time
+
+u64 spawnerNameHash(std::string_view name, u64 h) {
+    for (char c : name) h = (h ^ (u8)c) * FNV64_PRIME;
+    return h;
+}
+
+// ============================================================
+// Templates
+// ============================================================
+
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+void NameTemplates::add(std::string_view name) {
+    Template t;
+    std::string key, lit;
+    for (size_t i = 0; i < name.size();) {
+        bool letter = name[i] >= 'A' && name[i] <= 'Z' && (i == 0 || name[i - 1] == '_') &&
+                      i + 1 < name.size() && isDigit(name[i + 1]);
+        if (!letter && !isDigit(name[i])) {
+            lit += name[i];
+            key += name[i++];
+            continue;
+        }
+        size_t j = i + 1;
+        if (!letter) while (j < name.size() && isDigit(name[j])) j++;
+
+        // Tagged by what precedes it in its '_' segment: "a" in a0301, "@" in F50
+        size_t us = key.rfind('_');
+        Field f;
+        f.letter = letter;
+        f.width  = (int)(j - i);
+        f.tag    = key.substr(us == std::string::npos ? 0 : us + 1) +
+                   (letter ? std::string("@") : "#" + std::to_string(f.width));
+        m_seen[f.tag].emplace(name.substr(i, j - i));
+
+        t.literals.push_back(std::move(lit));
+        lit.clear();
+        t.fields.push_back(std::move(f));
+        key.append(j - i, letter ? '@' : '#');
+        i = j;
+    }
+    t.literals.push_back(std::move(lit));
+    if (t.fields.size() > (size_t)NAME_FIELDS_MAX) return;
+    m_templates.emplace(std::move(key), std::move(t));
+}
+
+void NameTemplates::clear() {
+    m_templates.clear();
+    m_seen.clear();
+    m_pools.clear();
+    m_ranges.clear();
+    m_plans.clear();
+}
+
+void NameTemplates::finish() {
+    // Padded with HASH_LANES zero values so a partial lane group reads in bounds
+    auto padValues = [](Values& v) { v.chars.append((size_t)HASH_LANES * v.width, '0'); };
+    m_pools.clear();
+    for (auto& [tag, texts] : m_seen) {
+        std::vector<std::string> sorted(texts.begin(), texts.end());
+        std::sort(sorted.begin(), sorted.end());
+        Values& v = m_pools[tag];
+        v.width = (int)sorted[0].size();
+        v.count = (u32)sorted.size();
+        for (const std::string& s : sorted) v.chars += s;
+        padValues(v);
+    }
+    m_letters = Values();
+    m_letters.width = 1;
+    for (char c = 'A'; c <= 'Z'; c++) m_letters.chars += c;
+    m_letters.count = 26;
+    padValues(m_letters);
+
+    m_plans.clear();
+    for (const auto& [key, t] : m_templates) {
+        Plan p;
+        p.tmpl = &t;
+        p.blocks = 1;
+        for (size_t i = 0; i < t.fields.size(); i++) {
+            const Field& f = t.fields[i];
+            const Values* v = &m_pools[f.tag];
+            if (f.letter) {
+                v = &m_letters;
+            } else if (i + 1 == t.fields.size() && f.width <= RANGE_MAX_WIDTH) {
+                Values& r = m_ranges[f.width];
+                if (!r.count) {
+                    r.width = f.width;
+                    r.count = 1;
+                    for (int w = 0; w < f.width; w++) r.count *= 10;
+                    char buf[8];
+                    for (u32 n = 0; n < r.count; n++) {
+                        snprintf(buf, sizeof(buf), "%0*u", f.width, n);
+                        r.chars += buf;
+                    }
+                    padValues(r);
+                }
+                v = &r;
+            }
+            p.fields.push_back(v);
+            if (i + 1 < t.fields.size()) p.blocks *= v->count;
+        }
+        m_plans.push_back(std::move(p));
+    }
+}
+
+u64 NameTemplates::candidates() const {
+    u64 n = 0;
+    for (const Plan& p : m_plans) n += p.blocks * (p.fields.empty() ? 1 : p.fields.back()->count);
+    return n;
+}
+
+// ============================================================
+// Search
+// ============================================================
+
+// Membership by the top 16 bits first, so almost every miss costs one load
+class NameTemplates::Targets {
+public:
+    explicit Targets(const std::vector<u64>& hashes) : m_sorted(hashes), m_bits(65536 / 64, 0) {
+        std::sort(m_sorted.begin(), m_sorted.end());
+        for (u64 h : m_sorted) m_bits[h >> 54] |= 1ULL << ((h >> 48) & 63);
+    }
+    bool contains(u64 h) const {
+        return ((m_bits[h >> 54] >> ((h >> 48) & 63)) & 1) &&
+               std::binary_search(m_sorted.begin(), m_sorted.end(), h);
+    }
+
+private:
+    std::vector<u64> m_sorted;
+    std::vector<u64> m_bits;
+};
+
+void NameTemplates::searchBlocks(const Plan& p, u64 first, u64 last, const Targets& targets,
+                                 std::vector<NameMatch>& out) const {
+    const Template& t = *p.tmpl;
+    const int nf = (int)p.fields.size();
+    if (nf == 0) {
+        u64 h = spawnerNameHash(t.literals[0]);
+        if (targets.contains(h)) out.push_back({h, t.literals[0]});
+        return;
+    }
+    const Values& lane = *p.fields[nf - 1];
+    const std::string& suffix = t.literals[nf];
+    std::string prefix;
+    for (u64 b = first; b < last; b++) {
+        // Block b in mixed radix over the fields before the lane field
+        u32 idx[NAME_FIELDS_MAX] = {};
+        u64 rest = b;
+        for (int f = nf - 2; f >= 0; f--) {
+            idx[f] = (u32)(rest % p.fields[f]->count);
+            rest /= p.fields[f]->count;
+        }
+        prefix.clear();
+        for (int f = 0; f < nf - 1; f++) {
+            prefix += t.literals[f];
+            prefix.append(p.fields[f]->at(idx[f]), p.fields[f]->width);
+        }
+        prefix += t.literals[nf - 1];
+        const u64 hp = spawnerNameHash(prefix);
+
+        for (u32 v = 0; v < lane.count; v += HASH_LANES) {
+            u64 h[HASH_LANES];
+            for (int l = 0; l < HASH_LANES; l++) h[l] = hp;
+            for (int c = 0; c < lane.width; c++)
+                for (int l = 0; l < HASH_LANES; l++)
+                    h[l] = (h[l] ^ (u8)lane.at(v + l)[c]) * FNV64_PRIME;
+            for (char c : suffix)
+                for (int l = 0; l < HASH_LANES; l++)
+                    h[l] = (h[l] ^ (u8)c) * FNV64_PRIME;
+            const int lanes = (int)std::min<u32>(HASH_LANES, lane.count - v);
+            for (int l = 0; l < lanes; l++)
+                if (targets.contains(h[l]))
+                    out.push_back({h[l], prefix + std::string(lane.at(v + l), lane.width) + suffix});
+        }
+    }
+}
+
+static void sortMatches(std::vector<NameMatch>& out) {
+    std::sort(out.begin(), out.end(), [](const NameMatch& a, const NameMatch& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+    });
+    out.erase(std::unique(out.begin(), out.end(), [](const NameMatch& a, const NameMatch& b) {
+        return a.hash == b.hash && a.name == b.name;
+    }), out.end());
+}
+
+u64 NameTemplates::search(const std::vector<u64>& targets, int threads, std::vector<NameMatch>& out,
+                          const std::atomic<bool>* cancel) const {
+    if (targets.empty() || m_plans.empty()) return 0;
+    const Targets set(targets);
+    if (threads <= 0) threads = workerCores();
+
+    // Blocks of every plan back to back; workers take SEARCH_CHUNK at a time
+    std::vector<u64> start(m_plans.size() + 1, 0);
+    for (size_t i = 0; i < m_plans.size(); i++) start[i + 1] = start[i] + m_plans[i].blocks;
+    const u64 total = start.back();
+    std::atomic<u64> next{0};
+    std::mutex outMutex;
+
+    auto work = [&] {
+        std::vector<NameMatch> found;
+        for (;;) {
+            if (cancel && *cancel) break;
+            u64 b = next.fetch_add(SEARCH_CHUNK);
+            if (b >= total) break;
+            u64 e = std::min(total, b + SEARCH_CHUNK);
+            size_t pi = std::upper_bound(start.begin(), start.end(), b) - start.begin() - 1;
+            for (; b < e; pi++) {
+                u64 pe = std::min(e, start[pi + 1]);
+                searchBlocks(m_plans[pi], b - start[pi], pe - start[pi], set, found);
+                b = pe;
+            }
+        }
+        std::lock_guard<std::mutex> lock(outMutex);
+        out.insert(out.end(), found.begin(), found.end());
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back([&work, t] { pinToCore(t); work(); });
+    work();
+    for (std::thread& th : pool) th.join();
+
+    sortMatches(out);
+    return cancel && *cancel ? 0 : candidates();
+}
+
+u64 NameTemplates::searchScalar(const std::vector<u64>& targets, std::vector<NameMatch>& out) const {
+    if (targets.empty()) return 0;
+    const Targets set(targets);
+    u64 hashed = 0;
+    std::string name;
+    for (const Plan& p : m_plans) {
+        const Template& t = *p.tmpl;
+        const int nf = (int)p.fields.size();
+        const u32 laneCount = nf ? p.fields[nf - 1]->count : 1;
+        for (u64 b = 0; b < p.blocks; b++) {
+            for (u32 v = 0; v < laneCount; v++) {
+                u64 rest = b;
+                u32 idx[NAME_FIELDS_MAX] = {};
+                for (int f = nf - 2; f >= 0; f--) {
+                    idx[f] = (u32)(rest % p.fields[f]->count);
+                    rest /= p.fields[f]->count;
+                }
+                if (nf) idx[nf - 1] = v;
+                name.clear();
+                for (int f = 0; f < nf; f++) {
+                    name += t.literals[f];
+                    name.append(p.fields[f]->at(idx[f]), p.fields[f]->width);
+                }
+                name += t.literals[nf];
+                u64 h = spawnerNameHash(name);
+                hashed++;
+                if (set.contains(h)) out.push_back({h, name});
+            }
+        }
+    }
+    sortMatches(out);
+    return hashed;
+}
+
+// ============================================================
+// Lookup
+// ============================================================
+
+void SpawnerNameLookup::load() {
+    FILE* f = fopen(DATA_ROOT "spawner_names.txt", "r");
+    if (!f) return;
+    char line[256], name[200];
+    unsigned long long hash;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (fgets(line, sizeof(line), f))
+        if (sscanf(line, "%16llx %199s", &hash, name) == 2) m_names[hash] = name;
+    fclose(f);
+}
+
+void SpawnerNameLookup::record(const NameMatch& m) {
+    makeDirs(DATA_ROOT);
+    FILE* f = fopen(DATA_ROOT "spawner_names.txt", "a");
+    if (!f) return;
+    fprintf(f, "%016llX %s\n", (unsigned long long)m.hash, m.name.c_str());
+    fclose(f);
+}
+
+void SpawnerNameLookup::request(const std::vector<u64>& hashes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_quit) return;
+    bool added = false;
+    for (u64 h : hashes) {
+        if (m_names.count(h) || m_searched.count(h)) continue;
+        if (std::find(m_pending.begin(), m_pending.end(), h) != m_pending.end()) continue;
+        m_pending.push_back(h);
+        added = true;
+    }
+    if (!added) return;
+    if (!m_worker.joinable()) m_worker = std::thread(&SpawnerNameLookup::run, this);
+    m_wake.notify_one();
+}
+
+void SpawnerNameLookup::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+bool SpawnerNameLookup::name(u64 hash, std::string& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_names.find(hash);
+    if (it == m_names.end()) return false;
+    out = it->second;
+    return true;
+}
+
+bool SpawnerNameLookup::searched(u64 hash) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_searched.count(hash) && !m_names.count(hash);
+}
+
+bool SpawnerNameLookup::busy() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_busy || !m_pending.empty();
+}
+
+void SpawnerNameLookup::run() {
+    pinToCore(0);   // search() runs worker 0 on this thread
+    std::vector<u64> batch;
+    std::vector<NameMatch> found;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_busy = false;
+            m_wake.wait(lock, [this] { return m_quit || !m_pending.empty(); });
+            if (m_quit) return;
+            batch.swap(m_pending);
+            m_pending.clear();
+            m_busy = true;
+        }
+        found.clear();
+        g_nameTemplates.search(batch, 0, found, &m_quit);
+        if (m_quit) return;   // the batch was not searched in full
+        for (const NameMatch& m : found) record(m);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (u64 h : batch) m_searched.insert(h);
+        for (const NameMatch& m : found) m_names.emplace(m.hash, m.name);
+    }
+}
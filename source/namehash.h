@@ -0,0 +1,139 @@
+#pragma once
+#include <switch.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// ============================================================
+// Spawner Names
+// ============================================================
+//
+// A spawner's hash is the 64-bit FNV-1a of its name (the third column
+// of the spawner files, "spn_outzone_a0402_F50") from the game's offset
+// basis, which is TERMINATOR_HASH, the hash of the empty name. A stash
+// entry whose hash is in no spawner file can still be named by hashing
+// likely names until one matches.
+//
+// Likely names come from the known ones. Every run of digits is a
+// decimal field of the same width and a lone capital before digits
+// ("_F50") a letter field. Names that agree outside their fields share
+// a template, e.g. "spn_outzone_a####_@##". A field takes every value
+// seen under the same tag anywhere ("a" + 4 digits: all area codes),
+// a letter field A-Z, and a template's last field its whole range
+// (000-999), so spawners next to known ones are covered.
+//
+// The search hashes the fixed part of a name once per block, then
+// HASH_LANES names that differ only in the last field at a time, with
+// the lanes' multiply chains interleaved so they overlap in the
+// pipeline. 64-bit multiplies have no vector form on the console's
+// NEON, so the lanes are scalar. Blocks are shared out to one pinned
+// thread per usable core (see workers.h).
+
+static constexpr u64 SPAWNER_HASH_BASIS = 0xCBF29CE484222645ULL;
+static constexpr u64 FNV64_PRIME        = 0x100000001B3ULL;
+static constexpr int HASH_LANES         = 8;
+
+u64 spawnerNameHash(std::string_view name, u64 h = SPAWNER_HASH_BASIS);
+
+struct NameMatch {
+    u64         hash;
+    std::string name;
+};
+
+class NameTemplates {
+public:
+    void add(std::string_view name);   // a known spawner name
+    void finish();                     // after the last add, before searching
+    void clear();
+
+    size_t templates() const { return m_templates.size(); }
+    u64    candidates() const;
+
+    // Candidates whose hash is in `targets`, hashed on `threads` workers
+    // (0: workerCores()). Returns the number of names hashed, or 0 if
+    // `cancel` is set by the time it returns; `out` may then be partial.
+    u64 search(const std::vector<u64>& targets, int threads, std::vector<NameMatch>& out,
+               const std::atomic<bool>* cancel = nullptr) const;
+
+    // The same names built one at a time and hashed in full (baseline)
+    u64 searchScalar(const std::vector<u64>& targets, std::vector<NameMatch>& out) const;
+
+private:
+    struct Field {
+        std::string tag;     // pool key: text since the last '_', width, kind
+        bool letter;
+        int  width;
+    };
+    struct Template {
+        std::vector<std::string> literals;   // fields.size() + 1 pieces
+        std::vector<Field>       fields;
+    };
+    struct Values {
+        int         width = 0;
+        u32         count = 0;
+        std::string chars;   // count values of `width` characters, back to back
+        const char* at(u32 i) const { return chars.data() + (size_t)i * width; }
+    };
+    struct Plan {
+        const Template*             tmpl;
+        std::vector<const Values*>  fields;   // last one is the lane field
+        u64                         blocks;   // product of all but the last count
+    };
+    class Targets;
+
+    void searchBlocks(const Plan& p, u64 first, u64 last, const Targets& targets,
+                      std::vector<NameMatch>& out) const;
+
+    std::map<std::string, Template>         m_templates;        // by template text
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_seen;   // tag -> field texts
+    std::unordered_map<std::string, Values> m_pools;            // tag -> sorted values
+    std::unordered_map<int, Values>         m_ranges;           // width -> every decimal value
+    Values                                  m_letters;
+    std::vector<Plan>                       m_plans;
+};
+
+// ============================================================
+// Lookup
+// ============================================================
+//
+// Names unknown stash hashes on a worker thread. Every hash is searched
+// once per run; matches are appended to DATA_ROOT "spawner_names.txt"
+// and read back at startup, so a name costs one search ever.
+
+class SpawnerNameLookup {
+public:
+    ~SpawnerNameLookup() { stop(); }
+
+    void load();                                 // recorded matches
+    void request(const std::vector<u64>& hashes);
+    void stop();
+
+    bool name(u64 hash, std::string& out);       // false while unknown
+    bool searched(u64 hash);                     // searched without a match
+    bool busy();
+
+private:
+    void run();
+    void record(const NameMatch& m);
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::thread             m_worker;
+    std::atomic<bool>       m_quit{false};   // also cancels a running search
+    bool                    m_busy = false;
+    std::vector<u64>        m_pending;
+    std::unordered_set<u64> m_searched;
+    std::unordered_map<u64, std::string> m_names;
+};
+
+// Built from the spawner files by loadData().
+extern NameTemplates     g_nameTemplates;
+extern SpawnerNameLookup g_spawnerNames;
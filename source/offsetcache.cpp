@@ -0,0 +1,96 @@
+#include "offsetcache.h"
+#include "digest.h"
+#include "memsource.h"
+#include "paths.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static constexpr u32 FINGERPRINT_BYTES = 0x1000;
+
+static std::vector<CachedOffsets> g_cache;
+static bool g_cacheLoaded = false;
+
+static bool parseLine(char* line, CachedOffsets& out) {
+    char bid[32], chain[128];
+    unsigned long long base, fp;
+    if (sscanf(line, "%31s %llx %127s %llx", bid, &base, chain, &fp) != 4) return false;
+    if (strlen(bid) != 16) return false;
+    for (int i = 0; i < 8; i++) {
+        char hex[3] = {bid[i * 2], bid[i * 2 + 1], 0};
+        out.buildId[i] = (u8)strtoul(hex, nullptr, 16);
+    }
+    out.basePointer = base;
+    out.fingerprint = fp;
+    out.chainLen = 0;
+    for (char* tok = strtok(chain, ","); tok && out.chainLen < PTR_CHAIN_MAX; tok = strtok(nullptr, ","))
+        out.chain[out.chainLen++] = strtoull(tok, nullptr, 16);
+    return out.chainLen > 0;
+}
+
+void loadOffsetCache() {
+    g_cacheLoaded = true;
+    g_cache.clear();
+    FILE* f = fopen(DATA_ROOT "offsets.cache", "r");
+    if (!f) return;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        CachedOffsets e;
+        if (parseLine(line, e)) g_cache.push_back(e);
+    }
+    fclose(f);
+}
+
+static void saveOffsetCache() {
+    makeDirs(DATA_ROOT);
+    FILE* f = fopen(DATA_ROOT "offsets.cache", "w");
+    if (!f) return;
+    fprintf(f, "# build_id base_pointer chain fingerprint (written by Shiny Stash Live Map)\n");
+    for (const auto& e : g_cache) {
+        for (int i = 0; i < 8; i++) fprintf(f, "%02X", e.buildId[i]);
+        fprintf(f, " %llX ", (unsigned long long)e.basePointer);
+        for (int i = 0; i < e.chainLen; i++)
+            fprintf(f, i ? ",%llX" : "%llX", (unsigned long long)e.chain[i]);
+        fprintf(f, " %016llX\n", (unsigned long long)e.fingerprint);
+    }
+    fclose(f);
+}
+
+const CachedOffsets* findCachedOffsets(const u8* buildId) {
+    if (!g_cacheLoaded) loadOffsetCache();
+    for (const auto& e : g_cache)
+        if (memcmp(e.buildId, buildId, 8) == 0) return &e;
+    return nullptr;
+}
+
+void storeCachedOffsets(const CachedOffsets& entry) {
+    if (!g_cacheLoaded) loadOffsetCache();
+    for (auto& e : g_cache) {
+        if (memcmp(e.buildId, entry.buildId, 8) == 0) {
+            e = entry;
+            saveOffsetCache();
+            return;
+        }
+    }
+    g_cache.push_back(entry);
+    saveOffsetCache();
+}
+
+void dropCachedOffsets(const u8* buildId) {
+    if (!g_cacheLoaded) loadOffsetCache();
+    for (size_t i = 0; i < g_cache.size(); i++) {
+        if (memcmp(g_cache[i].buildId, buildId, 8) != 0) continue;
+        g_cache.erase(g_cache.begin() + i);
+        saveOffsetCache();
+        return;
+    }
+}
+
+u64 nsoFingerprint(MemorySource& mem, const DmntCheatProcessMetadata& meta) {
+    u8 page[FINGERPRINT_BYTES];
+    if (R_FAILED(mem.read(meta.main_nso_extents.base, page, sizeof(page)))) return 0;
+    return digest64(page, sizeof(page)) ^ meta.main_nso_extents.size;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <switch.h>
+#include <switch/dmntcht.h>
+
+#include "profile.h"
+
+class MemorySource;
+
+// ============================================================
+// Offset Cache (DATA_ROOT "offsets.cache")
+// ============================================================
+//
+// Offsets derived at runtime (signature scan) are remembered per main
+// NSO build ID, so a game update pays for the scan once. One line per
+// build:
+//
+//   <build id> <base pointer> <chain,...> <fingerprint>
+//
+// The fingerprint is a digest64() of the start of the NSO's .text; an
+// entry whose fingerprint no longer matches, or whose pointer leads to
+// something that is not a stash, is dropped.
+
+struct CachedOffsets {
+    u8  buildId[8];
+    u64 basePointer;
+    u64 chain[PTR_CHAIN_MAX];
+    int chainLen;
+    u64 fingerprint;
+};
+
+void loadOffsetCache();
+const CachedOffsets* findCachedOffsets(const u8* buildId);
+void storeCachedOffsets(const CachedOffsets& entry);   // add or replace, then save
+void dropCachedOffsets(const u8* buildId);             // remove, then save
+
+// Digest of the first page of the main NSO (0 if unreadable).
+u64 nsoFingerprint(MemorySource& mem, const DmntCheatProcessMetadata& meta);
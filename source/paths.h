@@ -0,0 +1,16 @@
+#pragma once
+
+// Asset root. The host build overrides this to point at the
+// repository's romfs/ directory (see host/Makefile).
+#ifndef ROMFS_ROOT
+#define ROMFS_ROOT "romfs:/"
+#endif
+
+// Writable data directory (config, captures, caches). The host build
+// uses the working directory.
+#ifndef DATA_ROOT
+#define DATA_ROOT "sdmc:/switch/Shiny-Stash-Live-Map/"
+#endif
+
+// Creates every missing directory along `dir` (like mkdir -p).
+void makeDirs(const char* dir);
@@ -0,0 +1,168 @@
+#include "pkx.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// ============================================================
+// PKX Decryption (LCRNG XOR + Block Shuffle)
+// ============================================================
+
+static constexpr u32 LCRNG_MULT = 0x41C64E6D;
+static constexpr u32 LCRNG_ADD  = 0x00006073;
+
+// Stored order of blocks A-D for sv 0-23 is the lexicographic
+// permutation sv of "ABCD"; g_blockPos[sv * 4 + b] is where block b
+// sits in storage. sv 24-31 repeat 0-7.
+static constexpr auto g_blockPos = [] {
+    std::array<u8, 32 * 4> pos{};
+    std::array<u8, 4> stored = {0, 1, 2, 3};
+    for (int sv = 0; sv < 24; sv++) {
+        for (int i = 0; i < 4; i++) pos[sv * 4 + stored[i]] = (u8)i;
+        std::next_permutation(stored.begin(), stored.end());
+    }
+    for (int i = 24 * 4; i < 32 * 4; i++) pos[i] = pos[i - 24 * 4];
+    return pos;
+}();
+
+static_assert(g_blockPos[3 * 4 + 1] == 3 && g_blockPos[23 * 4] == 3 && g_blockPos[31 * 4 + 3] == 2,
+              "block order matches PKHeX BlockPosition");
+
+static void cryptPA9(u8* data, int len, u32 ec) {
+    u32 seed = ec;
+    int count = (len - PKX_HEADER) / 2;
+    u16* ptr = (u16*)(data + PKX_HEADER);
+    for (int i = 0; i < count; i++) {
+        seed = seed * LCRNG_MULT + LCRNG_ADD;
+        ptr[i] ^= (u16)(seed >> 16);
+    }
+}
+
+void decryptPA9(u8* data, int len) {
+    u32 ec;
+    memcpy(&ec, data, sizeof(u32));
+
+    // XOR decrypt from byte 8 onwards
+    cryptPA9(data, len, ec);
+
+    // Unshuffle 4 blocks
+    u32 sv = (ec >> 13) & 31;
+    u8 temp[4 * PKX_BLOCK];
+    const u8* order = &g_blockPos[sv * 4];
+    for (int b = 0; b < 4; b++)
+        memcpy(&temp[b * PKX_BLOCK], &data[PKX_HEADER + order[b] * PKX_BLOCK], PKX_BLOCK);
+    memcpy(&data[PKX_HEADER], temp, 4 * PKX_BLOCK);
+}
+
+void encryptPA9(u8* data, int len) {
+    u32 ec;
+    memcpy(&ec, data, sizeof(u32));
+
+    // Shuffle 4 blocks back into stored order
+    u32 sv = (ec >> 13) & 31;
+    u8 temp[4 * PKX_BLOCK];
+    const u8* order = &g_blockPos[sv * 4];
+    for (int b = 0; b < 4; b++)
+        memcpy(&temp[order[b] * PKX_BLOCK], &data[PKX_HEADER + b * PKX_BLOCK], PKX_BLOCK);
+    memcpy(&data[PKX_HEADER], temp, 4 * PKX_BLOCK);
+
+    cryptPA9(data, len, ec);
+}
+
+// ============================================================
+// PKX Checksum
+// ============================================================
+//
+// 160 words = 20 vectors of 8 lanes. Lane sums wrap mod 2^16 exactly
+// like the scalar sum, so only the final horizontal add differs.
+
+static_assert((PA9_STORED - PKX_HEADER) % 16 == 0, "checksum range is whole vectors");
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+u16 pa9Checksum(const u8* data) {
+    uint16x8_t acc = vdupq_n_u16(0);
+    for (int i = PKX_HEADER; i < PA9_STORED; i += 16)
+        acc = vaddq_u16(acc, vreinterpretq_u16_u8(vld1q_u8(data + i)));
+    return (u16)vaddvq_u16(acc);
+}
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+u16 pa9Checksum(const u8* data) {
+    __m128i acc = _mm_setzero_si128();
+    for (int i = PKX_HEADER; i < PA9_STORED; i += 16)
+        acc = _mm_add_epi16(acc, _mm_loadu_si128((const __m128i*)(data + i)));
+    acc = _mm_add_epi16(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_add_epi16(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_add_epi16(acc, _mm_srli_si128(acc, 2));
+    return (u16)_mm_cvtsi128_si32(acc);
+}
+#else
+u16 pa9Checksum(const u8* data) {
+    u16 sum = 0;
+    for (int i = PKX_HEADER; i < PA9_STORED; i += 2) {
+        u16 w;
+        memcpy(&w, data + i, sizeof(u16));
+        sum += w;
+    }
+    return sum;
+}
+#endif
+
+bool pa9ChecksumValid(const u8* data) {
+    u16 stored;
+    memcpy(&stored, data + PKX_CHECKSUM_OFF, sizeof(u16));
+    return stored == pa9Checksum(data);
+}
+
+void pa9UpdateChecksum(u8* data) {
+    u16 sum = pa9Checksum(data);
+    memcpy(data + PKX_CHECKSUM_OFF, &sum, sizeof(u16));
+}
+
+// ============================================================
+// Gen9 Species Converter
+// ============================================================
+
+static constexpr s8 T9_OFFSET[] = {
+    65,-1,-1,-1,-1,31,31,47,47,29,29,53,31,31,46,44,30,30,-7,-7,-7,13,13,
+    -2,-2,23,23,24,-21,-21,27,27,47,47,47,26,14,-33,-33,-33,-17,-17,3,-29,
+    12,-12,-31,-31,-31,3,3,-24,-24,-44,-44,-30,-30,-28,-28,23,23,6,7,29,8,
+    3,4,4,20,4,23,6,3,3,4,-1,13,9,7,5,7,9,9,-43,-43,-43,-68,-68,-68,-58,
+    -58,-25,-29,-31,6,-1,6,0,0,0,3,3,4,2,3,3,-5,-12,-12,
+};
+
+// Gen9 renumbered species from raw 917 on; T9_OFFSET[raw - 917] is the
+// national dex number minus the raw ID. Both directions are expanded
+// into dense tables at compile time.
+static constexpr int T9_BASE    = 917;
+static constexpr int RAW9_COUNT = T9_BASE + (int)sizeof(T9_OFFSET);
+
+static constexpr auto g_national9 = [] {
+    std::array<u16, RAW9_COUNT> nat{};
+    for (int raw = 0; raw < RAW9_COUNT; raw++)
+        nat[raw] = (u16)(raw < T9_BASE ? raw : raw + T9_OFFSET[raw - T9_BASE]);
+    return nat;
+}();
+
+static constexpr int NAT9_COUNT = [] {
+    int n = RAW9_COUNT;
+    for (u16 v : g_national9) n = std::max(n, v + 1);
+    return n;
+}();
+
+// First raw ID per national number wins, like the old linear search
+static constexpr auto g_internal9 = [] {
+    std::array<u16, NAT9_COUNT> raw{};
+    for (int i = 0; i < NAT9_COUNT; i++) raw[i] = (u16)i;
+    for (int r = RAW9_COUNT - 1; r >= T9_BASE; r--) raw[g_national9[r]] = (u16)r;
+    return raw;
+}();
+
+u16 getNational9(u16 raw) {
+    return raw < RAW9_COUNT ? g_national9[raw] : raw;
+}
+
+u16 getInternal9(u16 ndex) {
+    return ndex < NAT9_COUNT ? g_internal9[ndex] : ndex;
+}
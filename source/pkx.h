@@ -0,0 +1,27 @@
+#pragma once
+#include <switch.h>
+
+// ============================================================
+// PKX Decryption (LCRNG XOR + Block Shuffle)
+// ============================================================
+
+static constexpr int PKX_HEADER = 8;   // EC(4) + Sanity(2) + Checksum(2)
+static constexpr int PKX_BLOCK  = 80;  // 0x50 bytes per block
+static constexpr int PA9_SIZE   = 0x158;  // header + 4 blocks + party stats
+static constexpr int PA9_STORED = 0x148;  // checksummed range ends here
+static constexpr int PKX_CHECKSUM_OFF = 6;
+
+void decryptPA9(u8* data, int len);
+void encryptPA9(u8* data, int len);   // inverse of decryptPA9, used to synthesize stashes
+
+// u16 sum over the decrypted stored data, as kept in header bytes 6-7.
+u16  pa9Checksum(const u8* data);
+bool pa9ChecksumValid(const u8* data);
+void pa9UpdateChecksum(u8* data);
+
+// ============================================================
+// Gen9 Species Converter
+// ============================================================
+
+u16 getNational9(u16 raw);
+u16 getInternal9(u16 ndex);           // inverse of getNational9
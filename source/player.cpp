@@ -0,0 +1,167 @@
+#include "player.h"
+#include "memsource.h"
+#include "profile.h"
+#include "timing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+PlayerTracker g_player;
+
+static constexpr double RAD_TO_DEG = 57.29577951308232;
+
+// ============================================================
+// Position
+// ============================================================
+
+Result resolvePlayerAddress(MemorySource& mem, u64 mainBase, const u64* chain, int len, u64* outAddr) {
+    u64 addr = mainBase + chain[0];
+    u64 ptr;
+    for (int i = 1; i < len; i++) {
+        Result rc = mem.read(addr, &ptr, sizeof(u64));
+        if (R_FAILED(rc)) return rc;
+        addr = ptr + chain[i];
+    }
+    *outAddr = addr;
+    return 0;
+}
+
+bool playerPosValid(const PlayerPos& p) {
+    for (float v : {p.x, p.y, p.z})
+        if (!std::isfinite(v) || std::fabs(v) > PLAYER_COORD_MAX) return false;
+    return p.x != 0 || p.y != 0 || p.z != 0;
+}
+
+PlayerPos interpolatePlayer(const PlayerSample& a, const PlayerSample& b, u64 ns) {
+    if (ns >= b.ns || b.ns <= a.ns) return b.pos;
+    if (ns <= a.ns) return a.pos;
+    if (std::hypot(b.pos.x - a.pos.x, b.pos.z - a.pos.z) > PLAYER_SNAP_DIST) return b.pos;
+    float t = (float)(ns - a.ns) / (float)(b.ns - a.ns);
+    return {a.pos.x + (b.pos.x - a.pos.x) * t,
+            a.pos.y + (b.pos.y - a.pos.y) * t,
+            a.pos.z + (b.pos.z - a.pos.z) * t};
+}
+
+void playerBearing(const MapTransform& tr, const PlayerPos& from, float toX, float toZ,
+                   float* dist, float* deg) {
+    *dist = std::hypot(toX - from.x, toZ - from.z);
+    double dx = tr.convertX(toX) - tr.convertX(from.x);
+    double dz = tr.convertZ(toZ) - tr.convertZ(from.z);
+    double a = std::atan2(dx, -dz) * RAD_TO_DEG;
+    *deg = (float)(a < 0 ? a + 360.0 : a);
+}
+
+const char* compassPoint(float deg) {
+    static const char* const names[8] = {"N", "NE", "E", "SE", "S", "SW", "W", "NW"};
+    return names[(int)std::lround(deg / 45.0f) & 7];
+}
+
+// ============================================================
+// Tracker
+// ============================================================
+
+void PlayerTracker::start(MemorySource& mem, const DmntCheatProcessMetadata& meta, int hz) {
+    stop();
+    if (g_profile.playerChainLen == 0 || hz <= 0) return;
+    m_mem = &mem;
+    m_mainBase = meta.main_nso_extents.base;
+    m_periodNs = 1'000'000'000ULL / (u64)std::min(hz, PLAYER_MAX_HZ);
+    m_quit = false;
+    m_samples = 0;
+    m_mapIdx = -1;
+    m_stats = PlayerStats();
+    m_worker = std::thread(&PlayerTracker::run, this);
+}
+
+void PlayerTracker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+    m_samples = 0;
+}
+
+bool PlayerTracker::position(u64 ns, PlayerPos& out, int* mapIdx) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_samples == 0 || ns > m_hist[1].ns + PLAYER_STALE_NS) return false;
+    out = m_samples == 1 ? m_hist[1].pos : interpolatePlayer(m_hist[0], m_hist[1], ns - m_periodNs);
+    if (mapIdx) *mapIdx = m_mapIdx;
+    return true;
+}
+
+PlayerStats PlayerTracker::stats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+// The zone changes with a warp or a map transition, which moves the
+// player further than PLAYER_SNAP_DIST in one tick; without such a jump
+// it is re-read every PLAYER_ZONE_NS, so most ticks are one read.
+void PlayerTracker::run() {
+    u64 addr = 0, zoneAddr = 0;
+    u64 next = nowNs(), zoneNs = 0;
+    PlayerPos last = {};
+    bool haveLast = false;
+    int mapIdx = -1;
+    for (;;) {
+        int resolved = 0, read = 0;
+        if (!addr) {
+            resolved++;
+            if (R_FAILED(resolvePlayerAddress(*m_mem, m_mainBase, g_profile.playerChain,
+                                              g_profile.playerChainLen, &addr)))
+                addr = 0;
+        }
+        PlayerPos p;
+        bool ok = false;
+        if (addr) {
+            read++;
+            ok = R_SUCCEEDED(m_mem->read(addr, &p, sizeof(p))) && playerPosValid(p);
+            if (!ok) addr = 0;
+        }
+
+        if (ok && g_profile.playerMapChainLen) {
+            bool jumped = !haveLast || std::hypot(p.x - last.x, p.z - last.z) > PLAYER_SNAP_DIST;
+            u64 t = nowNs();
+            if (jumped || !zoneAddr || t >= zoneNs + PLAYER_ZONE_NS) {
+                zoneNs = t;
+                mapIdx = -1;
+                if (!zoneAddr) {
+                    resolved++;
+                    if (R_FAILED(resolvePlayerAddress(*m_mem, m_mainBase, g_profile.playerMapChain,
+                                                      g_profile.playerMapChainLen, &zoneAddr)))
+                        zoneAddr = 0;
+                }
+                u32 zone;
+                if (zoneAddr) {
+                    read++;
+                    if (R_SUCCEEDED(m_mem->read(zoneAddr, &zone, sizeof(zone)))) mapIdx = findMapByZone(zone);
+                    else zoneAddr = 0;
+                }
+            }
+        }
+        if (ok) { last = p; haveLast = true; }
+        u64 now = nowNs();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stats.ticks++;
+        m_stats.resolves += resolved;
+        m_stats.reads    += read;
+        m_stats.misses   += !ok;
+        if (ok) {
+            // A map change starts the history over instead of sliding
+            if (mapIdx != m_mapIdx) m_samples = 0;
+            m_hist[0] = m_hist[1];
+            m_hist[1] = {p, now};
+            m_samples = std::min(m_samples + 1, 2);
+            m_mapIdx = mapIdx;
+        }
+
+        // A late tick does not make the next ones come faster
+        next += m_periodNs;
+        if (next < now) next = now + m_periodNs;
+        if (m_wake.wait_for(lock, std::chrono::nanoseconds(next - now), [this] { return m_quit; })) return;
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <switch.h>
+#include <switch/dmntcht.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "spawners.h"
+
+class MemorySource;
+
+// ============================================================
+// Player Tracking
+// ============================================================
+//
+// The player's world position: x, y, z floats at the end of the
+// profile's player_chain. A worker thread walks the chain once, then
+// reads the 12 position bytes from the resolved address every tick -
+// a single dmnt read per tick, at most PLAYER_MAX_HZ. The chain is
+// walked again only after a failed read or a value that cannot be a
+// position (not finite, out of range, or all zero while loading).
+//
+// With a player_map_chain in the profile, the u32 zone id at its end
+// names the map the player is on. It is read on the first tick, after a
+// jump (warp, map change) and otherwise every PLAYER_ZONE_NS. Without
+// one, the position alone cannot tell the maps apart, since they share
+// world coordinates.
+//
+// Samples are stamped when their read returns. position() draws one
+// tick in the past, between the two samples around that time, so the
+// marker moves smoothly at any frame rate. A step longer than
+// PLAYER_SNAP_DIST (warp, map change) jumps instead of sliding.
+
+static constexpr int   PLAYER_MAX_HZ    = 30;
+static constexpr float PLAYER_COORD_MAX = 100000.0f;
+static constexpr float PLAYER_SNAP_DIST = 60.0f;          // world units between samples
+static constexpr u64   PLAYER_STALE_NS  = 500'000'000;    // no sample for this long: hidden
+static constexpr u64   PLAYER_ZONE_NS   = 1'000'000'000;  // zone re-read without a jump
+
+struct PlayerPos {
+    float x, y, z;
+};
+static_assert(sizeof(PlayerPos) == 12, "PlayerPos is read in one piece");
+
+struct PlayerSample {
+    PlayerPos pos;
+    u64       ns;
+};
+
+struct PlayerStats {
+    u64 ticks    = 0;
+    u64 reads    = 0;   // position and zone reads
+    u64 resolves = 0;   // chain walks
+    u64 misses   = 0;   // ticks without a valid position
+};
+
+// Walks main + chain[0], then [addr] + chain[i] like the stash chain.
+Result resolvePlayerAddress(MemorySource& mem, u64 mainBase, const u64* chain, int len, u64* outAddr);
+bool   playerPosValid(const PlayerPos& p);
+
+// Position at `ns` from samples a (older) and b.
+PlayerPos interpolatePlayer(const PlayerSample& a, const PlayerSample& b, u64 ns);
+
+// Distance in the x/z plane (world units) and bearing in degrees
+// clockwise from map-up, through the map's texture orientation.
+void playerBearing(const MapTransform& tr, const PlayerPos& from, float toX, float toZ,
+                   float* dist, float* deg);
+const char* compassPoint(float deg);   // "N", "NE", ...
+
+class PlayerTracker {
+public:
+    ~PlayerTracker() { stop(); }
+
+    // Polls g_profile.playerChain at `hz` (1..PLAYER_MAX_HZ). `mem` is used
+    // from the worker, so it must be shared safely (SharedMemorySource).
+    void start(MemorySource& mem, const DmntCheatProcessMetadata& meta, int hz);
+    void stop();
+    bool running() const { return m_worker.joinable(); }
+
+    // Interpolated position for a frame drawn at `ns`; false without a
+    // recent valid sample. `mapIdx` gets the player's map, -1 when the
+    // profile has no player_map_chain or the zone matches no map.
+    bool position(u64 ns, PlayerPos& out, int* mapIdx = nullptr);
+    PlayerStats stats();
+
+private:
+    void run();
+
+    MemorySource*           m_mem = nullptr;
+    u64                     m_mainBase = 0;
+    u64                     m_periodNs = 0;
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::thread             m_worker;
+    bool                    m_quit = false;
+    int                     m_samples = 0;   // valid entries in m_hist
+    PlayerSample            m_hist[2] = {};  // [1] is the newest
+    int                     m_mapIdx = -1;   // of m_hist[1]
+    PlayerStats             m_stats;
+};
+
+extern PlayerTracker g_player;
@@ -0,0 +1,237 @@
+#include "profile.h"
+#include "paths.h"
+#include "pkx.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// romfs/profile.txt, embedded by the Makefile; used when neither file
+// loads.
+static const char BUILTIN_PROFILE[] =
+#include "profile_builtin.inc"
+    ;
+
+static const char* s_profileError = nullptr;
+static GameProfile loadStartupProfile();
+
+const GameProfile g_profile = loadStartupProfile();
+
+// ============================================================
+// Parsing
+// ============================================================
+
+static char* trim(char* s) {
+    while (*s == ' ' || *s == '\t') s++;
+    char* e = s + strlen(s);
+    while (e > s && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r' || e[-1] == '\n')) *--e = '\0';
+    return s;
+}
+
+static bool parseBuildId(const char* s, u8* out) {
+    if (strlen(s) != 16) return false;
+    for (int i = 0; i < 8; i++) {
+        char hex[3] = {s[i * 2], s[i * 2 + 1], 0};
+        char* ep;
+        out[i] = (u8)strtoul(hex, &ep, 16);
+        if (*ep) return false;
+    }
+    return true;
+}
+
+static u64 buildIdKey(const u8* buildId) {
+    u64 key;
+    memcpy(&key, buildId, sizeof(key));
+    return key;
+}
+
+static std::string assetPath(const char* p) {
+    if (*p == '/' || strchr(p, ':')) return p;
+    return std::string(ROMFS_ROOT) + p;
+}
+
+// "1662/10.291021" -> 161.5...
+static bool parseRatio(char*& s, double& out) {
+    char* ep;
+    out = strtod(s, &ep);
+    if (ep == s) return false;
+    if (*ep == '/') {
+        char* dp = ep + 1;
+        double d = strtod(dp, &ep);
+        if (ep == dp || d == 0) return false;
+        out /= d;
+    }
+    s = ep;
+    return true;
+}
+
+static bool parseVersion(char* v, GameVersion& out) {
+    char bid[32], name[32];
+    unsigned long long base;
+    if (sscanf(v, "%31s %31s %lli", bid, name, &base) != 3) return false;
+    if (!parseBuildId(bid, out.build_id) || strlen(name) >= sizeof(out.version)) return false;
+    snprintf(out.version, sizeof(out.version), "%s", name);
+    out.basePointer = base;
+    return true;
+}
+
+static bool parseMap(char* v, MapProfile& out) {
+    char* field[4];
+    for (int i = 0; i < 4; i++) {
+        field[i] = v;
+        char* bar = strchr(v, '|');
+        if (i < 3) {
+            if (!bar) return false;
+            *bar = '\0';
+            v = bar + 1;
+        }
+    }
+    // Optional zone id after the transform
+    if (char* bar = strchr(field[3], '|')) {
+        *bar = '\0';
+        char* z = trim(bar + 1);
+        char* ep;
+        out.zone = strtoll(z, &ep, 0);
+        if (ep == z || *ep || out.zone < 0 || out.zone > 0xFFFFFFFF) return false;
+    }
+    out.name     = trim(field[0]);
+    out.image    = assetPath(trim(field[1]));
+    out.spawners = assetPath(trim(field[2]));
+    if (out.name.empty()) return false;
+
+    double t[10];
+    char* s = field[3];
+    for (double& x : t)
+        if (!parseRatio(s, x)) return false;
+    if (*trim(s)) return false;
+    out.transform = {t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8], t[9]};
+    return true;
+}
+
+static bool parseChain(char* v, u64* chain, int& len) {
+    len = 0;
+    for (char* tok = strtok(v, ","); tok; tok = strtok(nullptr, ",")) {
+        if (len >= PTR_CHAIN_MAX) return false;
+        char* ep;
+        chain[len++] = strtoull(trim(tok), &ep, 0);
+        if (*ep) return false;
+    }
+    return len > 0;
+}
+
+// Fills `p` from profile text; on failure returns the reason.
+static const char* parseProfile(char* text, GameProfile& p) {
+    p = GameProfile();
+    int format = 0;
+    for (char* line = text; line; ) {
+        char* nl = strchr(line, '\n');
+        if (nl) *nl = '\0';
+        char* cur = line;
+        line = nl ? nl + 1 : nullptr;
+
+        char* hash = strchr(cur, '#');
+        if (hash) *hash = '\0';
+        char* eq = strchr(cur, '=');
+        if (!eq) {
+            if (*trim(cur)) return "Profile: bad line";
+            continue;
+        }
+        *eq = '\0';
+        const char* key = trim(cur);
+        char* val = trim(eq + 1);
+
+        bool ok = true;
+        if (!strcmp(key, "format"))          format = atoi(val);
+        else if (!strcmp(key, "title_id"))   p.titleId = strtoull(val, nullptr, 16);
+        else if (!strcmp(key, "stash_size")) p.stashSize = (int)strtol(val, nullptr, 0);
+        else if (!strcmp(key, "entry_size")) p.entrySize = (int)strtol(val, nullptr, 0);
+        else if (!strcmp(key, "pa9_offset")) p.pa9Offset = (int)strtol(val, nullptr, 0);
+        else if (!strcmp(key, "ptr_chain"))  ok = parseChain(val, p.chain, p.chainLen);
+        else if (!strcmp(key, "player_chain")) ok = parseChain(val, p.playerChain, p.playerChainLen);
+        else if (!strcmp(key, "player_map_chain")) ok = parseChain(val, p.playerMapChain, p.playerMapChainLen);
+        else if (!strcmp(key, "version")) {
+            GameVersion v;
+            ok = parseVersion(val, v);
+            if (ok) p.versions.push_back(v);
+        } else if (!strcmp(key, "map")) {
+            MapProfile m;
+            ok = parseMap(val, m);
+            if (ok) p.maps.push_back(std::move(m));
+        }
+        if (!ok) return "Profile: bad value";
+    }
+
+    if (format != PROFILE_FORMAT) return "Profile: unsupported format";
+    if (!p.titleId || p.chainLen == 0 || p.maps.empty() || (int)p.maps.size() > MAP_MAX)
+        return "Profile: incomplete";
+    if (p.entrySize <= 0 || p.pa9Offset < 8 || p.pa9Offset + PA9_SIZE > p.entrySize ||
+        p.stashSize < p.entrySize || p.stashSize > STASH_MAX_SIZE ||
+        p.stashSize / p.entrySize > STASH_MAX_SLOTS)
+        return "Profile: stash layout out of range";
+    p.slots = p.stashSize / p.entrySize;
+
+    // Several releases can share a build ID; the first listed wins
+    for (int i = 0; i < (int)p.versions.size(); i++)
+        p.versionIndex.emplace(buildIdKey(p.versions[i].build_id), i);
+    return nullptr;
+}
+
+static GameProfile parseBuiltin() {
+    GameProfile p;
+    std::string text(BUILTIN_PROFILE);
+    parseProfile(text.data(), p);
+    p.source = "built-in";
+    return p;
+}
+
+// ============================================================
+// Loading
+// ============================================================
+
+static bool readProfileFile(const char* path, std::string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    out.clear();
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+// Runs during static initialisation, before main() mounts romfs, so it
+// mounts romfs for the read itself. The SD card is mounted by then.
+static GameProfile loadStartupProfile() {
+    static const char* const paths[] = {DATA_ROOT "profile.txt", ROMFS_ROOT "profile.txt"};
+    romfsInit();
+    for (const char* path : paths) {
+        std::string text;
+        if (!readProfileFile(path, text)) continue;
+        GameProfile p;
+        const char* err = parseProfile(text.data(), p);
+        if (err) {
+            if (!s_profileError) s_profileError = err;
+            continue;
+        }
+        p.source = path;
+        romfsExit();
+        return p;
+    }
+    romfsExit();
+    return parseBuiltin();
+}
+
+const char* profileError() {
+    return s_profileError;
+}
+
+const GameVersion* findGameVersion(const u8* buildId) {
+    auto it = g_profile.versionIndex.find(buildIdKey(buildId));
+    return it != g_profile.versionIndex.end() ? &g_profile.versions[it->second] : nullptr;
+}
+
+int findMapByZone(u32 zone) {
+    for (int i = 0; i < (int)g_profile.maps.size(); i++)
+        if (g_profile.maps[i].zone == (s64)zone) return i;
+    return -1;
+}
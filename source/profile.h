@@ -0,0 +1,86 @@
+#pragma once
+#include <switch.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "spawners.h"
+
+// ============================================================
+// Game Profile (DATA_ROOT "profile.txt", else ROMFS_ROOT "profile.txt")
+// ============================================================
+//
+// Everything that changes with a game patch: title ID, build IDs and
+// base pointers, the pointer chain, the stash layout and the map list.
+// Plain "key = value" lines like config.ini, '#' starts a comment:
+//
+//   format     = 1
+//   title_id   = 0100F43008C44000
+//   stash_size = 4960
+//   entry_size = 0x1F0
+//   pa9_offset = 0x08
+//   ptr_chain  = 0x120, 0x168, 0x0
+//   player_chain = <main offset>, <offsets...>     (optional)
+//   player_map_chain = <main offset>, <offsets...> (optional)
+//   version    = <build id> <name> <base pointer>
+//   map        = <name> | <image> | <spawner file> | <10 transform values> [| <zone id>]
+//
+// Transform values are in MapTransform order and may be written as
+// "a/b". Asset paths are relative to ROMFS_ROOT unless absolute.
+// player_map_chain leads to the u32 zone id of the area the player is
+// in; a map's zone id is the value it reads there.
+//
+// A profile that fails to parse, or whose layout exceeds the buffer
+// limits below, is skipped; the built-in copy of romfs/profile.txt is
+// the last resort. The profile is loaded once, during static
+// initialisation, into the const g_profile and never changes after.
+
+static constexpr int PROFILE_FORMAT  = 1;
+static constexpr int STASH_MAX_SIZE  = 0x2000;
+static constexpr int STASH_MAX_SLOTS = 32;
+static constexpr int PTR_CHAIN_MAX   = 8;
+static constexpr int MAP_MAX         = 8;
+
+// Version detection via build ID (first 8 bytes of main_nso_build_id)
+struct GameVersion {
+    u8   build_id[8];
+    char version[16];
+    u64  basePointer;
+};
+
+struct MapProfile {
+    std::string  name;
+    std::string  image;      // resolved path
+    std::string  spawners;   // resolved path
+    MapTransform transform;
+    s64          zone = -1;  // player_map_chain value on this map, -1: none
+};
+
+struct GameProfile {
+    u64 titleId;
+    int stashSize;           // bytes read per refresh
+    int entrySize;
+    int slots;               // stashSize / entrySize
+    int pa9Offset;           // PA9 start within an entry (after the u64 hash)
+    u64 chain[PTR_CHAIN_MAX];
+    int chainLen;
+    u64 playerChain[PTR_CHAIN_MAX];   // [0] is relative to main, then as `chain`
+    int playerChainLen;               // 0: no player position for this game
+    u64 playerMapChain[PTR_CHAIN_MAX];   // to the player's u32 zone id
+    int playerMapChainLen;               // 0: the player's map is not known
+
+    std::vector<GameVersion>     versions;
+    std::unordered_map<u64, int> versionIndex;   // build ID as LE u64 -> first entry
+    std::vector<MapProfile>      maps;
+    std::string                  source;         // file it came from, or "built-in"
+};
+
+// The SD override, else romfs, else the built-in copy
+extern const GameProfile g_profile;
+
+// Error for the first profile file that was present but rejected, or nullptr.
+const char* profileError();
+
+const GameVersion* findGameVersion(const u8* buildId);
+int findMapByZone(u32 zone);   // -1 if no map has that zone id
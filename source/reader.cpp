@@ -0,0 +1,429 @@
+#include "reader.h"
+#include "digest.h"
+#include "memsource.h"
+#include "offsetcache.h"
+#include "sigscan.h"
+#include "timing.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+bool StashReader::attach(MemorySource& mem, bool retryScan) {
+    if (scanning()) {
+        if (!m_scanDone) return false;   // status() still reports the scan
+        return finishScan();
+    }
+    detach();
+    m_ver = nullptr;
+    m_bid.clear();
+
+    const char* err = mem.open();
+    if (err) { m_status = err; return false; }
+
+    Result rc = mem.getMetadata(&m_meta);
+    if (R_FAILED(rc)) {
+        m_status = "Metadata read failed";
+        mem.close();
+        return false;
+    }
+    if (m_meta.title_id != g_profile.titleId) {
+        m_status = "Pokemon Legends: Z-A is not running";
+        mem.close();
+        return false;
+    }
+
+    // Detect game version from build ID
+    char bid[24];
+    snprintf(bid, sizeof(bid), "%02X%02X%02X%02X%02X%02X%02X%02X",
+        m_meta.main_nso_build_id[0], m_meta.main_nso_build_id[1],
+        m_meta.main_nso_build_id[2], m_meta.main_nso_build_id[3],
+        m_meta.main_nso_build_id[4], m_meta.main_nso_build_id[5],
+        m_meta.main_nso_build_id[6], m_meta.main_nso_build_id[7]);
+    m_bid = bid;
+
+    if (m_scanOpt.cache) m_ver = useCachedOffsets(mem);
+    if (!m_ver) m_ver = findGameVersion(m_meta.main_nso_build_id);
+    if (!m_ver && m_scanOpt.enabled) {
+        // Unknown build: look for the code that loads the stash global
+        if (scanBlocked(retryScan)) { mem.close(); return false; }
+        startScan(mem);
+        return false;
+    }
+    if (!m_ver) {
+        m_status = "Unsupported game version";
+        mem.close();
+        return false;
+    }
+
+    startSession(mem);
+    return true;
+}
+
+void StashReader::startSession(MemorySource& mem) {
+    m_mem = &mem;
+    m_cheatTried = false;
+    m_haveSnapshot = false;
+    m_pauseProbed = false;
+    m_pauseRefused = false;
+    m_verifyAttempt = 0;
+    m_stats = StashStats();
+    m_status.clear();
+}
+
+void StashReader::detach() {
+    if (scanning()) {
+        // A cancelled scan proves nothing, so it is not remembered
+        m_scanCancel = true;
+        m_scanWorker.join();
+        m_scanMem->close();
+        m_scanMem = nullptr;
+    }
+    if (!m_mem) return;
+    removeCheat();
+    m_mem->close();
+    m_mem = nullptr;
+}
+
+// ============================================================
+// Base Pointer Scan
+// ============================================================
+
+bool StashReader::scanBlocked(bool retryScan) {
+    auto it = m_scanFailures.find(m_bid);
+    if (it == m_scanFailures.end() || retryScan) return false;
+    const ScanFailure& f = it->second;
+    if (f.kind == BaseCheck::Unreachable && nowNs() >= f.retryAtNs) return false;
+    setScanFailureStatus(f);
+    return true;
+}
+
+void StashReader::setScanFailureStatus(const ScanFailure& f) {
+    if (f.kind == BaseCheck::Invalid) {
+        m_status = "Unsupported game version";
+        return;
+    }
+    u64 now = nowNs();
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Stash not found (save loaded?), retry in %llu s or A",
+             (unsigned long long)((f.retryAtNs > now ? f.retryAtNs - now : 0) / 1000000000ULL));
+    m_status = msg;
+}
+
+// The session stays open for the worker; nothing else uses `mem` until
+// finishScan() or detach() takes it back.
+void StashReader::startScan(MemorySource& mem) {
+    m_scanMem = &mem;
+    m_scanDone = false;
+    m_scanCancel = false;
+    m_status = "Scanning for the stash pointer...";
+    m_scanWorker = std::thread([this] {
+        m_scanOk = detectBasePointer(*m_scanMem, m_meta, m_scanOpt, m_scanOut, &m_scanCancel);
+        m_scanDone = true;
+    });
+}
+
+bool StashReader::finishScan() {
+    m_scanWorker.join();
+    MemorySource& mem = *m_scanMem;
+    m_scanMem = nullptr;
+    m_lastScan = m_scanOut;
+    m_lastScanFound = m_scanOk;
+
+    if (m_scanOk) {
+        m_scanFailures.erase(m_bid);
+        m_autoVer = {{}, "auto", m_scanOut.basePointer};
+        memcpy(m_autoVer.build_id, m_meta.main_nso_build_id, 8);
+        m_ver = &m_autoVer;
+        if (m_scanOpt.cache) cacheOffsets(mem, m_scanOut.basePointer);
+        startSession(mem);
+        return true;
+    }
+
+    ScanFailure& f = m_scanFailures[m_bid];
+    f.kind = m_scanOut.unreachable ? BaseCheck::Unreachable : BaseCheck::Invalid;
+    f.failures++;
+    f.retryAtNs = nowNs() + std::min(SCAN_RETRY_NS << std::min(f.failures - 1, 8), SCAN_RETRY_MAX_NS);
+    setScanFailureStatus(f);
+    mem.close();
+    return false;
+}
+
+// ============================================================
+// Offset Cache
+// ============================================================
+//
+// A cached entry is trusted only while the NSO fingerprint matches and
+// the pointer does not lead to a block that fails the stash check; an
+// unreachable chain or an empty stash (no save loaded yet) keeps the entry.
+
+const GameVersion* StashReader::useCachedOffsets(MemorySource& mem) {
+    const CachedOffsets* c = findCachedOffsets(m_meta.main_nso_build_id);
+    if (!c) return nullptr;
+
+    bool sameChain = c->chainLen == g_profile.chainLen &&
+                     memcmp(c->chain, g_profile.chain, c->chainLen * sizeof(u64)) == 0;
+    if (!sameChain || c->fingerprint != nsoFingerprint(mem, m_meta) ||
+        checkBasePointer(mem, m_meta, c->basePointer) == BaseCheck::Invalid) {
+        dropCachedOffsets(m_meta.main_nso_build_id);
+        return nullptr;
+    }
+
+    const GameVersion* known = findGameVersion(m_meta.main_nso_build_id);
+    m_autoVer = {{}, "auto", c->basePointer};
+    if (known) memcpy(m_autoVer.version, known->version, sizeof(m_autoVer.version));
+    memcpy(m_autoVer.build_id, m_meta.main_nso_build_id, 8);
+    return &m_autoVer;
+}
+
+void StashReader::cacheOffsets(MemorySource& mem, u64 basePointer) {
+    CachedOffsets c = {};
+    memcpy(c.buildId, m_meta.main_nso_build_id, 8);
+    c.basePointer = basePointer;
+    c.chainLen = g_profile.chainLen;
+    memcpy(c.chain, g_profile.chain, c.chainLen * sizeof(u64));
+    c.fingerprint = nsoFingerprint(mem, m_meta);
+    storeCachedOffsets(c);
+}
+
+// Backoff before the first re-read after a torn read; doubles per retry.
+static constexpr u64 VERIFY_BACKOFF_NS = 500000;
+
+// ============================================================
+// Pointer Resolution
+// ============================================================
+//
+// With cheat_vm on, a dmnt cheat walks the chain every game frame and
+// leaves the stash address in a static register, so a refresh costs
+// one register read instead of one dependent memory read per chain link.
+// The cheat is installed on the second refresh of a session, so one-shot
+// reads never touch the cheat list, and before any pause window, so
+// the install is never timed against the pause budget. The first
+// non-zero value is checked against a walk once; a program that
+// disagrees is removed and the session goes back to walking.
+
+void StashReader::installCheat() {
+    DmntCheatDefinition def;
+    buildStashCheat(*m_ver, &def);
+    m_cheatTried = true;
+    m_mem->writeStaticRegister(STASH_STATIC_REG, 0);
+    if (R_FAILED(m_mem->addCheat(def, &m_cheatId))) m_cheatId = 0;
+    m_cheatVerified = false;
+}
+
+void StashReader::removeCheat() {
+    if (!m_cheatId) return;
+    m_mem->removeCheat(m_cheatId);
+    m_cheatId = 0;
+}
+
+Result StashReader::walkChain(u64* addr) {
+    m_stats.lastIpc += g_profile.chainLen;
+    return resolveStashAddress(*m_mem, m_meta, *m_ver, addr);
+}
+
+Result StashReader::resolve(u64* addr) {
+    if (!m_cheatId) return walkChain(addr);
+
+    u64 v = 0;
+    Result rc = m_mem->readStaticRegister(STASH_STATIC_REG, &v);
+    m_stats.lastIpc++;
+    if (R_FAILED(rc) || v == 0) return walkChain(addr);   // VM has not run a frame yet
+    if (m_cheatVerified) { *addr = v; return 0; }
+
+    rc = walkChain(addr);
+    if (R_FAILED(rc)) return rc;
+    if (*addr == v) m_cheatVerified = true;
+    else            removeCheat();
+    return 0;
+}
+
+Result StashReader::readBlock(u64 addr, u8* buf, u64* slotDigest) {
+    Result rc = m_mem->read(addr, buf, g_profile.stashSize);
+    m_stats.reads++;
+    m_stats.lastIpc++;
+    if (R_FAILED(rc)) return rc;
+
+    const int n = g_profile.slots, es = g_profile.entrySize;
+    u64 td = nowNs();
+    for (int i = 0; i < n; i++)
+        slotDigest[i] = digest64(&buf[i * es], es);
+    m_stats.lastDigestNs = nowNs() - td;
+    return 0;
+}
+
+// Checksum only what would be decoded anyway: slots that differ from
+// the last accepted snapshot.
+bool StashReader::changedSlotsValid(const u8* buf, const u64* slotDigest) {
+    for (int i = 0; i < g_profile.slots; i++) {
+        if (m_haveSnapshot && slotDigest[i] == m_slotDigest[i]) continue;
+        StashSlot slot;
+        decodeSlot(&buf[i * g_profile.entrySize], slot);
+        if (!slot.checksumOk) return false;
+    }
+    return true;
+}
+
+// One verification read per call. A retry is not slept for on the
+// caller's thread: it returns Retry and the next refresh() after
+// m_verifyAtNs comes back here with m_buf and its digests unchanged.
+StashReader::Snapshot StashReader::readVerified(u64 addr, u64* slotDigest) {
+    u64 again[STASH_MAX_SLOTS];
+    const size_t digestBytes = g_profile.slots * sizeof(u64);
+    if (m_verifyAttempt == 0) m_verifySettled = false;
+
+    if (R_FAILED(readBlock(addr, m_verifyBuf, again))) {
+        m_verifyAttempt = 0;
+        m_status = "Stash read failed";
+        return Snapshot::Failed;
+    }
+    if (memcmp(again, slotDigest, digestBytes) != 0) {
+        // The newer read becomes the reference for the next attempt
+        m_stats.tornReads++;
+        m_verifySettled = false;
+        memcpy(m_buf, m_verifyBuf, g_profile.stashSize);
+        memcpy(slotDigest, again, digestBytes);
+    } else if (m_opt.checksum && !changedSlotsValid(m_buf, slotDigest)) {
+        // Stable but corrupt: both reads landed inside the same write
+        m_stats.badChecksums++;
+        m_verifySettled = true;
+    } else {
+        m_verifyAttempt = 0;
+        return Snapshot::Ok;
+    }
+
+    if (m_verifyAttempt < m_opt.retries) {
+        m_verifyAttempt++;
+        m_verifyAddr = addr;
+        m_verifyAtNs = nowNs() + (VERIFY_BACKOFF_NS << (m_verifyAttempt - 1));
+        memcpy(m_verifyDigest, slotDigest, digestBytes);
+        return Snapshot::Retry;
+    }
+    m_verifyAttempt = 0;
+    // Reads agreed but some slot never passed: that record is really
+    // corrupt, not torn. Accept it; buildEntries flags it.
+    if (m_verifySettled) return Snapshot::Ok;
+    m_stats.rejected++;
+    return Snapshot::Unstable;
+}
+
+void StashReader::refusePause(u64 ns) {
+    m_pauseRefused = true;
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Pause %llu us over %d us budget, using verified reads",
+             (unsigned long long)(ns / 1000), m_opt.pauseBudgetUs);
+    m_status = msg;
+}
+
+// The pause window holds only the pointer walk and one stash read;
+// digests and decoding run after the game is resumed. The first call
+// per session times the same reads unpaused and refuses to pause at
+// all if they alone would blow the budget.
+StashReader::Snapshot StashReader::readPaused(u64* slotDigest) {
+    const u64 budgetNs = (u64)m_opt.pauseBudgetUs * 1000;
+    u64 addr;
+
+    if (!m_pauseProbed) {
+        m_pauseProbed = true;
+        u64 t0 = nowNs();
+        if (R_SUCCEEDED(resolve(&addr)))
+            m_mem->read(addr, m_verifyBuf, g_profile.stashSize);
+        u64 ns = nowNs() - t0;
+        if (ns > budgetNs) { refusePause(ns); return Snapshot::Refused; }
+    }
+
+    u64 t0 = nowNs();
+    Result rc = m_mem->pause();
+    if (R_FAILED(rc)) { m_status = "Pause failed"; return Snapshot::Failed; }
+    rc = resolve(&addr);
+    if (R_SUCCEEDED(rc)) rc = m_mem->read(addr, m_buf, g_profile.stashSize);
+    m_mem->resume();
+    m_stats.lastIpc += 3;   // pause, read, resume
+    u64 ns = nowNs() - t0;
+
+    m_stats.pauses++;
+    m_stats.lastPauseNs = ns;
+    m_stats.maxPauseNs = std::max(m_stats.maxPauseNs, ns);
+    m_stats.reads++;
+    if (ns > budgetNs) refusePause(ns);   // this snapshot is still consistent
+
+    if (R_FAILED(rc)) { m_status = "Stash read failed"; return Snapshot::Failed; }
+
+    const int n = g_profile.slots, es = g_profile.entrySize;
+    u64 td = nowNs();
+    for (int i = 0; i < n; i++)
+        slotDigest[i] = digest64(&m_buf[i * es], es);
+    m_stats.lastDigestNs = nowNs() - td;
+    return Snapshot::Ok;
+}
+
+RefreshResult StashReader::refresh(std::vector<ShinyEntry>& entries) {
+    if (!m_mem) return RefreshResult::Error;
+    if (m_verifyAttempt > 0 && nowNs() < m_verifyAtNs) return RefreshResult::Pending;
+    u64 t0 = nowNs();
+    m_stats.polls++;
+    m_stats.lastIpc = 0;
+
+    const int slots = g_profile.slots;
+    const size_t digestBytes = slots * sizeof(u64);
+    u64 slotDigest[STASH_MAX_SLOTS];
+    Snapshot snap = Snapshot::Refused;
+    if (m_verifyAttempt > 0) {
+        // Next attempt of a verification started by an earlier refresh
+        memcpy(slotDigest, m_verifyDigest, digestBytes);
+        snap = readVerified(m_verifyAddr, slotDigest);
+    } else {
+        if (m_opt.cheatVm && !m_cheatTried && m_stats.polls >= 2) installCheat();
+        if (m_opt.mode == SnapshotMode::Paused && !m_pauseRefused)
+            snap = readPaused(slotDigest);
+    }
+
+    if (snap == Snapshot::Refused) {
+        u64 addr;
+        Result rc = resolve(&addr);
+        if (R_FAILED(rc)) { m_status = "Pointer resolve failed"; return RefreshResult::Error; }
+
+        rc = readBlock(addr, m_buf, slotDigest);
+        if (R_FAILED(rc)) { m_status = "Stash read failed"; return RefreshResult::Error; }
+
+        // A refused pause degrades to verified reads rather than plain ones
+        snap = Snapshot::Ok;
+        if (m_opt.mode != SnapshotMode::Plain)
+            snap = readVerified(addr, slotDigest);
+    }
+
+    if (snap == Snapshot::Retry) {
+        m_stats.lastPollNs = nowNs() - t0;
+        return RefreshResult::Pending;
+    }
+    if (snap == Snapshot::Failed) return RefreshResult::Error;
+    if (snap == Snapshot::Unstable) {
+        m_stats.lastPollNs = nowNs() - t0;
+        if (!m_haveSnapshot) { m_status = "Stash unstable, try again"; return RefreshResult::Error; }
+        return RefreshResult::Unchanged;
+    }
+
+    // Change detection: per-slot digests, block digest over the slot digests
+    u64 digest = digest64(slotDigest, digestBytes);
+    bool same = m_haveSnapshot && digest == m_digest &&
+                memcmp(slotDigest, m_slotDigest, digestBytes) == 0;
+
+    if (same) {
+        m_stats.lastPollNs = nowNs() - t0;
+        return RefreshResult::Unchanged;
+    }
+
+    for (int i = 0; i < slots; i++) {
+        if (m_haveSnapshot && slotDigest[i] == m_slotDigest[i]) continue;
+        decodeSlot(&m_buf[i * g_profile.entrySize], m_slots[i]);
+        m_stats.slotsDecoded++;
+    }
+    memcpy(m_slotDigest, slotDigest, digestBytes);
+    m_digest = digest;
+    m_haveSnapshot = true;
+
+    buildEntries(m_slots, slots, entries);
+    m_stats.changes++;
+    m_stats.lastPollNs = nowNs() - t0;
+    return RefreshResult::Changed;
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <switch.h>
+#include <switch/dmntcht.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "config.h"
+#include "sigscan.h"
+#include "stash.h"
+
+class MemorySource;
+
+// ============================================================
+// Stash Reader
+// ============================================================
+//
+// Owns a session with the game process: build detection, pointer
+// resolution and change detection between refreshes. Each slot of
+// the raw block is reduced to a digest64(); a refresh whose slot
+// digests all match the previous snapshot returns Unchanged without
+// decrypting anything or touching the entry list. Changed slots are
+// decrypted again, unchanged ones reuse their cached decode.
+//
+// The game keeps writing while we read, so a single read can mix two
+// states of the stash. In SnapshotMode::Verified the block is read
+// again until two consecutive reads have identical slot digests (and,
+// optionally, every changed slot passes its PA9 checksum). The reader
+// never sleeps: a read that has to be retried makes refresh() return
+// Pending, and the next refresh() at or after retryAtNs() makes the
+// next attempt, with the back-off doubling per attempt. A snapshot that
+// never settles is rejected: the previous entries stay on screen and
+// the refresh reports Unchanged.
+//
+// SnapshotMode::Paused suspends the game for the pointer walk and one
+// stash read instead. Every pause is timed; once one exceeds the
+// configured budget the session falls back to verified reads.
+//
+// Builds missing from the profile are located with detectBasePointer()
+// (see sigscan.h) when scanning is enabled; version() reports "auto".
+// The scan reads all of .text, so it runs on a worker: attach() starts it
+// and returns false, and the attach() after scanFinished() takes the
+// result. A scan that finds nothing is remembered per build ID. When some
+// candidate was Unreachable (no save loaded yet) the build is scanned
+// again after SCAN_RETRY_NS, doubling per failure up to SCAN_RETRY_MAX_NS;
+// when every candidate was Invalid, only an attach(mem, true) rescans it.
+//
+// SnapshotOptions::cheatVm moves the pointer walk into a dmnt cheat
+// (see buildStashCheat); the cheat lives until detach().
+
+enum class RefreshResult { Unchanged, Changed, Error, Pending };
+
+static constexpr u64 SCAN_RETRY_NS     = 30'000'000'000;    // first back-off after a failed scan
+static constexpr u64 SCAN_RETRY_MAX_NS = 600'000'000'000;
+
+struct StashStats {
+    u64 polls        = 0;
+    u64 changes      = 0;
+    u64 lastPollNs   = 0;   // whole refresh including memory reads
+    u64 lastDigestNs = 0;   // digest + compare of the last refresh
+    u64 slotsDecoded = 0;   // total slots decrypted since attach
+    u64 reads        = 0;   // stash block reads, including verification
+    u64 tornReads    = 0;   // verification reads that disagreed
+    u64 badChecksums = 0;   // stable reads rejected by the PA9 checksum
+    u64 rejected     = 0;   // refreshes that never settled
+    u64 pauses       = 0;
+    u64 lastPauseNs  = 0;   // pause-to-resume window of the last paused read
+    u64 maxPauseNs   = 0;
+    u64 lastIpc      = 0;   // dmnt calls made by the last refresh
+};
+
+class StashReader {
+public:
+    ~StashReader() { detach(); }
+
+    // Opens the memory source and identifies the running build.
+    // On failure returns false and status() explains why. `retryScan`
+    // rescans a build whose last scan failed, ignoring the back-off.
+    bool attach(MemorySource& mem, bool retryScan = false);
+    void detach();   // also cancels a running scan
+    bool attached() const { return m_mem != nullptr; }
+
+    bool scanning() const     { return m_scanWorker.joinable(); }
+    bool scanFinished() const { return m_scanDone; }
+
+    // Reads the stash; `entries` is rebuilt only when Changed.
+    RefreshResult refresh(std::vector<ShinyEntry>& entries);
+    u64 retryAtNs() const { return m_verifyAtNs; }   // after Pending
+
+    // Forgets the previous snapshot so the next refresh reports Changed.
+    void invalidate() { m_haveSnapshot = false; }
+
+    void setSnapshotOptions(const SnapshotOptions& opt) { m_opt = opt; }
+    void setScanOptions(const ScanOptions& opt)         { m_scanOpt = opt; }
+
+    // Result of the last completed scan of an unknown build; elapsedNs is 0 before one
+    const ScanResult& lastScan() const { return m_lastScan; }
+    bool lastScanFound() const         { return m_lastScanFound; }
+
+    const std::string& status() const  { return m_status; }
+    const std::string& buildId() const { return m_bid; }
+    const char* version() const        { return m_ver ? m_ver->version : ""; }
+    const DmntCheatProcessMetadata& metadata() const { return m_meta; }
+    u64 digest() const                 { return m_digest; }
+    const StashStats& stats() const    { return m_stats; }
+    bool pauseRefused() const          { return m_pauseRefused; }
+    bool cheatActive() const           { return m_cheatId != 0; }
+
+private:
+    enum class Snapshot { Ok, Unstable, Failed, Refused, Retry };
+
+    struct ScanFailure {
+        BaseCheck kind;        // Unreachable or Invalid
+        int       failures;
+        u64       retryAtNs;   // Unreachable only
+    };
+
+    void     startSession(MemorySource& mem);
+    bool     scanBlocked(bool retryScan);
+    void     startScan(MemorySource& mem);
+    bool     finishScan();
+    void     setScanFailureStatus(const ScanFailure& f);
+    const GameVersion* useCachedOffsets(MemorySource& mem);
+    void     cacheOffsets(MemorySource& mem, u64 basePointer);
+    void     installCheat();
+    void     removeCheat();
+    Result   walkChain(u64* addr);
+    Result   resolve(u64* addr);
+    Result   readBlock(u64 addr, u8* buf, u64* slotDigest);
+    bool     changedSlotsValid(const u8* buf, const u64* slotDigest);
+    Snapshot readVerified(u64 addr, u64* slotDigest);
+    Snapshot readPaused(u64* slotDigest);
+    void     refusePause(u64 ns);
+
+    MemorySource*            m_mem = nullptr;
+    DmntCheatProcessMetadata m_meta = {};
+    const GameVersion*       m_ver = nullptr;
+    std::string              m_status;
+    std::string              m_bid;
+    SnapshotOptions          m_opt;
+    ScanOptions              m_scanOpt;
+    ScanResult               m_lastScan;
+    bool                     m_lastScanFound = false;
+    std::unordered_map<std::string, ScanFailure> m_scanFailures;   // by build ID
+    std::thread              m_scanWorker;
+    MemorySource*            m_scanMem = nullptr;   // held open by the worker
+    ScanResult               m_scanOut;
+    bool                     m_scanOk = false;
+    std::atomic<bool>        m_scanDone{false};
+    std::atomic<bool>        m_scanCancel{false};
+    GameVersion              m_autoVer = {};     // m_ver for a detected build
+    bool                     m_pauseProbed = false;
+    bool                     m_pauseRefused = false;
+    u32                      m_cheatId = 0;
+    bool                     m_cheatTried = false;
+    bool                     m_cheatVerified = false;
+
+    u8        m_buf[STASH_MAX_SIZE];
+    u8        m_verifyBuf[STASH_MAX_SIZE];
+    int       m_verifyAttempt = 0;   // retries made by the pending verification
+    bool      m_verifySettled = false;
+    u64       m_verifyAddr = 0;
+    u64       m_verifyAtNs = 0;
+    u64       m_verifyDigest[STASH_MAX_SLOTS] = {};   // of m_buf while pending
+    bool      m_haveSnapshot = false;
+    u64       m_digest = 0;
+    u64       m_slotDigest[STASH_MAX_SLOTS] = {};
+    StashSlot m_slots[STASH_MAX_SLOTS] = {};
+    StashStats m_stats;
+};
@@ -0,0 +1,102 @@
+#include "regions.h"
+#include "workers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+static std::vector<Region> g_regions[MAP_MAX];
+static std::atomic<bool>   g_regionsReady{false};
+static std::thread         g_regionWorker;
+
+struct HullPoint {
+    const char* location;
+    float x, z;
+};
+
+static float cross(const HullPoint& o, const HullPoint& a, const HullPoint& b) {
+    return (a.x - o.x) * (b.z - o.z) - (a.z - o.z) * (b.x - o.x);
+}
+
+// Monotone chain over pts[0, n), sorted by x then z
+static void hullOf(const HullPoint* pts, int n, Region& r) {
+    std::vector<HullPoint> h(2 * n);
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        while (k >= 2 && cross(h[k - 2], h[k - 1], pts[i]) <= 0) k--;
+        h[k++] = pts[i];
+    }
+    for (int i = n - 2, lower = k + 1; i >= 0; i--) {
+        while (k >= lower && cross(h[k - 2], h[k - 1], pts[i]) <= 0) k--;
+        h[k++] = pts[i];
+    }
+    k--;   // last point repeats the first
+    if (k < 3) return;
+
+    r.hull.reserve(2 * k);
+    r.minX = r.maxX = h[0].x;
+    r.minZ = r.maxZ = h[0].z;
+    for (int i = 0; i < k; i++) {
+        r.hull.push_back(h[i].x);
+        r.hull.push_back(h[i].z);
+        r.minX = std::min(r.minX, h[i].x); r.maxX = std::max(r.maxX, h[i].x);
+        r.minZ = std::min(r.minZ, h[i].z); r.maxZ = std::max(r.maxZ, h[i].z);
+    }
+    // Convex, so a fan from the first vertex covers it
+    r.indices.reserve(3 * (k - 2));
+    for (int i = 1; i + 1 < k; i++) {
+        r.indices.push_back(0);
+        r.indices.push_back(i);
+        r.indices.push_back(i + 1);
+    }
+}
+
+void buildRegions(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr,
+                  std::vector<Region>& out) {
+    out.clear();
+    std::vector<HullPoint> pts;
+    for (const auto& sp : spawners) {
+        if (sp.mapIdx != mapIdx || !sp.location || !sp.location[0]) continue;
+        pts.push_back({sp.location, (float)tr.convertX(sp.x), (float)tr.convertZ(sp.z)});
+    }
+    // Location names are interned: equal pointers, same place
+    std::sort(pts.begin(), pts.end(), [](const HullPoint& a, const HullPoint& b) {
+        if (a.location != b.location) return std::less<const char*>()(a.location, b.location);
+        return a.x != b.x ? a.x < b.x : a.z < b.z;
+    });
+    for (size_t i = 0; i < pts.size(); ) {
+        size_t j = i;
+        while (j < pts.size() && pts[j].location == pts[i].location) j++;
+        Region r;
+        r.location = pts[i].location;
+        hullOf(&pts[i], (int)(j - i), r);
+        if (!r.hull.empty()) out.push_back(std::move(r));
+        i = j;
+    }
+}
+
+void startRegionBuild() {
+    stopRegionBuild();
+    g_regionsReady = false;
+    g_regionWorker = std::thread([] {
+        pinToCore(workerCores() - 1);   // off the UI thread's core when there is another
+        for (int m = 0; m < MAP_MAX; m++) {
+            if (m < (int)g_profile.maps.size()) buildRegions(g_spawners, m, g_profile.maps[m].transform, g_regions[m]);
+            else                                g_regions[m].clear();
+        }
+        g_regionsReady = true;
+    });
+}
+
+void stopRegionBuild() {
+    if (g_regionWorker.joinable()) g_regionWorker.join();
+}
+
+bool regionsReady() {
+    return g_regionsReady;
+}
+
+const std::vector<Region>& regions(int mapIdx) {
+    static const std::vector<Region> none;
+    return g_regionsReady ? g_regions[mapIdx] : none;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <switch.h>
+
+#include <vector>
+
+#include "profile.h"
+#include "spawners.h"
+
+// ============================================================
+// Location Regions
+// ============================================================
+//
+// Convex hull of each location's spawners (Andrew's monotone chain,
+// O(n log n) per location) in texture pixels, kept with a triangle fan
+// so the renderer can fill it straight from the cache. Locations with
+// fewer than three distinct points have no region.
+//
+// startRegionBuild() computes every map on a worker thread so loading
+// does not wait for it; regions() is empty until regionsReady().
+
+struct Region {
+    const char*        location;   // interned, as in SpawnerEntry
+    std::vector<float> hull;       // x, z pairs in hull order
+    std::vector<int>   indices;    // triangles into hull
+    float minX, minZ, maxX, maxZ;
+};
+
+void buildRegions(const std::vector<SpawnerEntry>& spawners, int mapIdx, const MapTransform& tr,
+                  std::vector<Region>& out);
+
+void startRegionBuild();   // over g_spawners; call after they are loaded
+void stopRegionBuild();    // waits for the worker
+bool regionsReady();
+const std::vector<Region>& regions(int mapIdx);
@@ -0,0 +1,171 @@
+#include "route.h"
+
+#include <algorithm>
+#include <cmath>
+
+RoutePlanner g_routes;
+
+static constexpr float ROUTE_EPS = 1e-3f;   // min gain for a move, so passes terminate
+
+static float dist(const RoutePoint& a, const RoutePoint& b) {
+    return std::hypot(a.x - b.x, a.z - b.z);
+}
+
+// ============================================================
+// Heuristics
+// ============================================================
+
+void routeSeed(const std::vector<RoutePoint>& pts, std::vector<int>& order) {
+    const int n = (int)pts.size();
+    order.clear();
+    if (n == 0) return;
+    std::vector<bool> used(n, false);
+    int cur = 0;
+    used[0] = true;
+    order.push_back(0);
+    for (int step = 1; step < n; step++) {
+        int best = -1;
+        float bestD = 0;
+        for (int i = 0; i < n; i++) {
+            if (used[i]) continue;
+            float d = dist(pts[cur], pts[i]);
+            if (best < 0 || d < bestD) { best = i; bestD = d; }
+        }
+        used[best] = true;
+        order.push_back(best);
+        cur = best;
+    }
+}
+
+float routeLength(const std::vector<RoutePoint>& pts, const std::vector<int>& order) {
+    float len = 0;
+    for (size_t i = 1; i < order.size(); i++) len += dist(pts[order[i - 1]], pts[order[i]]);
+    return len;
+}
+
+bool routeImprove(const std::vector<RoutePoint>& pts, std::vector<int>& order) {
+    const int n = (int)order.size();
+    if (n < 3) return false;
+    // Distance between points (not positions); -1 is the open end and costs nothing
+    auto D = [&](int a, int b) { return (a < 0 || b < 0) ? 0.0f : dist(pts[a], pts[b]); };
+    auto at = [&](int pos) { return pos >= 0 && pos < n ? order[pos] : -1; };
+    bool improved = false;
+
+    // 2-opt: reverse order[i..j]
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (i == 0 && j == n - 1) continue;   // the whole path, same length
+            float before = D(at(i - 1), order[i]) + D(order[j], at(j + 1));
+            float after  = D(at(i - 1), order[j]) + D(order[i], at(j + 1));
+            if (after + ROUTE_EPS < before) {
+                std::reverse(order.begin() + i, order.begin() + j + 1);
+                improved = true;
+            }
+        }
+    }
+
+    // Or-opt: move order[i, i+len) between positions k and k+1, either way round
+    std::vector<int> seg;
+    for (int len = 1; len <= 3 && len < n; len++) {
+        for (int i = 0; i + len <= n; i++) {
+            int s0 = order[i], s1 = order[i + len - 1];
+            int prev = at(i - 1), next = at(i + len);
+            float best = D(prev, s0) + D(s1, next) - D(prev, next) - ROUTE_EPS;
+            int bestK = -2;
+            bool bestRev = false;
+            for (int k = -1; k < n; k++) {
+                if (k >= i - 1 && k <= i + len - 1) continue;   // where it already is
+                int a = at(k), b = at(k + 1);
+                float base = D(a, b);
+                float fwd = D(a, s0) + D(s1, b) - base;
+                float rev = D(a, s1) + D(s0, b) - base;
+                if (fwd < best) { best = fwd; bestK = k; bestRev = false; }
+                if (rev < best) { best = rev; bestK = k; bestRev = true; }
+            }
+            if (bestK == -2) continue;
+
+            seg.assign(order.begin() + i, order.begin() + i + len);
+            if (bestRev) std::reverse(seg.begin(), seg.end());
+            order.erase(order.begin() + i, order.begin() + i + len);
+            int ins = bestK + 1 - (bestK >= i ? len : 0);
+            order.insert(order.begin() + ins, seg.begin(), seg.end());
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+// ============================================================
+// Background planner
+// ============================================================
+
+void RoutePlanner::request(u64 key, const std::vector<RoutePoint>& pts) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_quit) return;
+    auto it = m_cache.find(key);
+    if (it != m_cache.end() && (it->second.done || m_runningKey == key)) return;
+    if (m_hasJob && m_jobKey == key) return;
+
+    m_jobKey = key;
+    m_jobPts = pts;
+    m_hasJob = true;
+    m_superseded = true;
+    if (!m_worker.joinable()) m_worker = std::thread(&RoutePlanner::run, this);
+    m_wake.notify_one();
+}
+
+bool RoutePlanner::result(u64 key, std::vector<int>& order, bool* done) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(key);
+    if (it == m_cache.end()) return false;
+    order = it->second.order;
+    if (done) *done = it->second.done;
+    return true;
+}
+
+void RoutePlanner::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        m_superseded = true;
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void RoutePlanner::publish(u64 key, const std::vector<int>& order, bool done) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cache.size() >= CACHE_MAX && !m_cache.count(key)) m_cache.clear();
+    Route& r = m_cache[key];
+    r.order = order;
+    r.done = done;
+}
+
+void RoutePlanner::run() {
+    std::vector<RoutePoint> pts;
+    std::vector<int> order;
+    for (;;) {
+        u64 key;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_runningKey = 0;
+            m_wake.wait(lock, [this] { return m_quit || m_hasJob; });
+            if (m_quit) return;
+            key = m_jobKey;
+            pts.swap(m_jobPts);
+            m_hasJob = false;
+            m_superseded = false;
+            m_runningKey = key;
+        }
+
+        routeSeed(pts, order);
+        publish(key, order, pts.size() < 3);
+        if (pts.size() < 3) continue;
+        bool finished = false;
+        while (!m_superseded) {
+            if (!routeImprove(pts, order)) { finished = true; break; }
+            publish(key, order, false);
+        }
+        if (finished) publish(key, order, true);
+    }
+}
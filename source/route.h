@@ -0,0 +1,68 @@
+#pragma once
+#include <switch.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================
+// Route Planner
+// ============================================================
+//
+// Short open path through a set of points on one map: a nearest-
+// neighbour seed, then 2-opt and Or-opt (segments of 1-3 points, either
+// direction) passes until neither finds a gain. Each pass is O(n^2), so
+// a few hundred points still refine in well under a second.
+//
+// RoutePlanner runs this on a worker thread. A request publishes the
+// seed right away and a better order after every improving pass, so the
+// UI can draw the route while it refines. Finished routes are cached by
+// the caller's key (a digest of the point set); a new request replaces
+// one still in progress.
+
+struct RoutePoint {
+    float x, z;
+};
+
+void  routeSeed(const std::vector<RoutePoint>& pts, std::vector<int>& order);
+bool  routeImprove(const std::vector<RoutePoint>& pts, std::vector<int>& order);   // one pass
+float routeLength(const std::vector<RoutePoint>& pts, const std::vector<int>& order);
+
+class RoutePlanner {
+public:
+    ~RoutePlanner() { stop(); }
+
+    void request(u64 key, const std::vector<RoutePoint>& pts);
+
+    // Latest order for `key` (indices into its points). False if nothing
+    // is known yet; `done` tells whether refinement has finished.
+    bool result(u64 key, std::vector<int>& order, bool* done = nullptr);
+
+    void stop();
+
+private:
+    struct Route {
+        std::vector<int> order;
+        bool done = false;
+    };
+    static constexpr size_t CACHE_MAX = 64;
+
+    void run();
+    void publish(u64 key, const std::vector<int>& order, bool done);
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::thread             m_worker;
+    bool                    m_quit = false;
+    bool                    m_hasJob = false;
+    std::atomic<bool>       m_superseded{false};   // a newer job is waiting
+    u64                     m_jobKey = 0;
+    u64                     m_runningKey = 0;
+    std::vector<RoutePoint> m_jobPts;
+    std::unordered_map<u64, Route> m_cache;
+};
+
+extern RoutePlanner g_routes;
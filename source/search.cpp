@@ -0,0 +1,215 @@
+#include "search.h"
+
+#include <algorithm>
+#include <cstring>
+
+SpawnerSearch g_search;
+
+void buildSpawnerSearch() {
+    g_search.build(g_spawners);
+}
+
+// ============================================================
+// Text
+// ============================================================
+
+// Latin-1 supplement U+00C0..U+00FF (UTF-8 C3 80..C3 BF) without accents
+static const char LATIN1_FOLD[] = "aaaaaaaceeeeiiiidnooooo*ouuuuyts"
+                                  "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+std::string foldSearchText(const char* s) {
+    std::string out;
+    for (; *s; s++) {
+        u8 c = (u8)*s;
+        if (c == 0xC3 && (u8)s[1] >= 0x80 && (u8)s[1] <= 0xBF) {
+            out += LATIN1_FOLD[(u8)*++s - 0x80];
+            continue;
+        }
+        out += (c >= 'A' && c <= 'Z') ? (char)(c + 32) : (char)c;
+    }
+    return out;
+}
+
+static u32 trigram(const char* p) {
+    return ((u32)(u8)p[0] << 16) | ((u32)(u8)p[1] << 8) | (u8)p[2];
+}
+
+// 1-16 hex digits, with an optional 0x
+static bool parseHashPrefix(const std::string& q, u64& prefix, int& digits) {
+    size_t i = q.compare(0, 2, "0x") == 0 ? 2 : 0;
+    digits = (int)(q.size() - i);
+    if (digits < 1 || digits > 16) return false;
+    prefix = 0;
+    for (; i < q.size(); i++) {
+        char c = q[i];
+        int v = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+        if (v < 0) return false;
+        prefix = prefix << 4 | (u64)v;
+    }
+    return true;
+}
+
+// ============================================================
+// Index
+// ============================================================
+
+void SpawnerSearch::build(const std::vector<SpawnerEntry>& spawners) {
+    m_spawners = &spawners;
+    const u32 n = (u32)spawners.size();
+
+    std::unordered_map<const char*, std::string> folded;
+    for (const SpawnerEntry& sp : spawners)
+        if (!folded.count(sp.location)) folded.emplace(sp.location, foldSearchText(sp.location));
+
+    m_order.resize(n);
+    for (u32 i = 0; i < n; i++) m_order[i] = i;
+    std::sort(m_order.begin(), m_order.end(), [&](u32 a, u32 b) {
+        const SpawnerEntry& sa = spawners[a];
+        const SpawnerEntry& sb = spawners[b];
+        if (sa.mapIdx != sb.mapIdx) return sa.mapIdx < sb.mapIdx;
+        if (sa.location != sb.location) {
+            int c = folded[sa.location].compare(folded[sb.location]);
+            if (c) return c < 0;
+            return std::less<const char*>()(sa.location, sb.location);
+        }
+        return sa.hash < sb.hash;
+    });
+
+    // One location id per (map, location) group, in browse order
+    m_rank.assign(n, 0);
+    m_locOf.assign(n, 0);
+    m_locName.clear();
+    m_locPos.clear();
+    m_byHash.clear();
+    m_byHash.reserve(n);
+    for (u32 pos = 0; pos < n; pos++) {
+        const SpawnerEntry& sp = spawners[m_order[pos]];
+        if (pos == 0 || sp.location != spawners[m_order[pos - 1]].location ||
+            sp.mapIdx != spawners[m_order[pos - 1]].mapIdx) {
+            m_locName.push_back(folded[sp.location]);
+            m_locPos.emplace_back();
+        }
+        u32 loc = (u32)m_locName.size() - 1;
+        m_rank[m_order[pos]] = pos;
+        m_locOf[pos] = loc;
+        m_locPos[loc].push_back(pos);
+        m_byHash.push_back({sp.hash, pos});
+    }
+    std::sort(m_byHash.begin(), m_byHash.end());
+
+    m_trigrams.clear();
+    for (u32 loc = 0; loc < (u32)m_locName.size(); loc++) {
+        const std::string& name = m_locName[loc];
+        for (size_t i = 0; i + 3 <= name.size(); i++) {
+            std::vector<u32>& list = m_trigrams[trigram(&name[i])];
+            if (list.empty() || list.back() != loc) list.push_back(loc);
+        }
+    }
+
+    m_memo.assign(m_locName.size(), -1);
+    m_query.clear();
+    m_result.clear();
+}
+
+int SpawnerSearch::positionOf(u32 spawner) const {
+    return spawner < m_rank.size() ? (int)m_rank[spawner] : -1;
+}
+
+bool SpawnerSearch::locationMatches(u32 loc, const std::string& q) const {
+    return m_locName[loc].find(q) != std::string::npos;
+}
+
+// ============================================================
+// Query
+// ============================================================
+
+const std::vector<u32>& SpawnerSearch::search(const std::string& query) {
+    std::string q = foldSearchText(query.c_str());
+    const u32 n = size();
+    u64 prefix = 0;
+    int digits = 0;
+    bool isHash = parseHashPrefix(q, prefix, digits);
+    const int shift = 4 * (16 - digits);
+
+    // "0x" alone is not a hash prefix yet, so "0x1" does not narrow it
+    bool narrowing = !m_query.empty() && q.compare(0, m_query.size(), m_query) == 0 &&
+                     (q.compare(0, 2, "0x") != 0 || m_query.size() > 2);
+
+    if (q.empty()) {
+        m_result.resize(n);
+        for (u32 i = 0; i < n; i++) m_result[i] = i;
+    } else if (narrowing) {
+        // Narrowing: every match of q also matched the previous query
+        std::fill(m_memo.begin(), m_memo.end(), -1);
+        size_t out = 0;
+        for (u32 pos : m_result) {
+            u32 loc = m_locOf[pos];
+            if (m_memo[loc] < 0) m_memo[loc] = locationMatches(loc, q);
+            bool keep = m_memo[loc] ||
+                        (isHash && ((*m_spawners)[m_order[pos]].hash >> shift) == prefix);
+            if (keep) m_result[out++] = pos;
+        }
+        m_result.resize(out);
+    } else {
+        m_result.clear();
+        if (q.size() >= 3) {
+            // Locations holding every trigram of q, then checked in full
+            const std::vector<u32>* shortest = nullptr;
+            std::vector<const std::vector<u32>*> lists;
+            bool none = false;
+            for (size_t i = 0; i + 3 <= q.size() && !none; i++) {
+                auto it = m_trigrams.find(trigram(&q[i]));
+                if (it == m_trigrams.end()) { none = true; break; }
+                lists.push_back(&it->second);
+                if (!shortest || it->second.size() < shortest->size()) shortest = &it->second;
+            }
+            if (!none) {
+                for (u32 loc : *shortest) {
+                    bool all = true;
+                    for (const std::vector<u32>* l : lists)
+                        if (l != shortest && !std::binary_search(l->begin(), l->end(), loc)) { all = false; break; }
+                    if (all && locationMatches(loc, q))
+                        m_result.insert(m_result.end(), m_locPos[loc].begin(), m_locPos[loc].end());
+                }
+            }
+        } else {
+            for (u32 loc = 0; loc < (u32)m_locName.size(); loc++)
+                if (locationMatches(loc, q))
+                    m_result.insert(m_result.end(), m_locPos[loc].begin(), m_locPos[loc].end());
+        }
+        if (isHash) {
+            u64 lo = prefix << shift;
+            u64 hi = lo | (shift ? (~0ULL >> (64 - shift)) : 0);
+            auto first = std::lower_bound(m_byHash.begin(), m_byHash.end(), std::make_pair(lo, 0u));
+            for (auto it = first; it != m_byHash.end() && it->first <= hi; ++it) m_result.push_back(it->second);
+            std::sort(m_result.begin(), m_result.end());
+            m_result.erase(std::unique(m_result.begin(), m_result.end()), m_result.end());
+        }
+    }
+    m_query = q;
+    return m_result;
+}
+
+void SpawnerSearch::buildRows(const std::vector<u32>& positions, std::vector<BrowserRow>& rows) const {
+    rows.clear();
+    int mapRow = -1, locRow = -1;
+    int curMap = -1;
+    u32 curLoc = ~0u;
+    for (u32 pos : positions) {
+        int map = (*m_spawners)[m_order[pos]].mapIdx;
+        if (map != curMap) {
+            curMap = map;
+            curLoc = ~0u;
+            mapRow = (int)rows.size();
+            rows.push_back({BrowserRow::Map, pos, 0});
+        }
+        if (m_locOf[pos] != curLoc) {
+            curLoc = m_locOf[pos];
+            locRow = (int)rows.size();
+            rows.push_back({BrowserRow::Location, pos, 0});
+        }
+        rows[mapRow].count++;
+        rows[locRow].count++;
+        rows.push_back({BrowserRow::Spawner, pos, 1});
+    }
+}
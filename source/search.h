@@ -0,0 +1,68 @@
+#pragma once
+#include <switch.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "spawners.h"
+
+// ============================================================
+// Spawner Search
+// ============================================================
+//
+// Every spawner in browse order (map, location, hash) with a
+// type-ahead filter. A query matches spawners whose location contains
+// it, ignoring case and Latin-1 accents ("academie" finds "Académie
+// Étoile"), and, when it is 1-16 hex digits, spawners whose hash starts
+// with it.
+//
+// Locations are found through a trigram index built once at load;
+// hash prefixes are a range of the spawners sorted by hash. A query
+// that extends the previous one only re-checks the previous matches,
+// so typing one more character costs O(matches), not O(spawners).
+
+struct BrowserRow {
+    enum Kind : u8 { Map, Location, Spawner };
+    Kind kind;
+    u32  pos;     // browse position (first of the group for headers)
+    u32  count;   // headers: matching spawners in the group
+};
+
+class SpawnerSearch {
+public:
+    void build(const std::vector<SpawnerEntry>& spawners);
+
+    // Browse positions matching `query`, ascending; all of them when empty
+    const std::vector<u32>& search(const std::string& query);
+
+    // Map and location headers, then the spawners under them
+    void buildRows(const std::vector<u32>& positions, std::vector<BrowserRow>& rows) const;
+
+    u32 size() const               { return (u32)m_order.size(); }
+    u32 spawnerAt(u32 pos) const   { return m_order[pos]; }   // index into the built vector
+    int positionOf(u32 spawner) const;                         // -1 if not indexed
+
+private:
+    bool locationMatches(u32 loc, const std::string& q) const;
+
+    const std::vector<SpawnerEntry>* m_spawners = nullptr;
+    std::vector<u32>         m_order;      // browse position -> spawner
+    std::vector<u32>         m_rank;       // spawner -> browse position
+    std::vector<u32>         m_locOf;      // browse position -> location id
+    std::vector<std::string> m_locName;    // folded, per location id
+    std::vector<std::vector<u32>> m_locPos;            // location id -> browse positions
+    std::unordered_map<u32, std::vector<u32>> m_trigrams;   // -> location ids, ascending
+    std::vector<std::pair<u64, u32>> m_byHash;          // (hash, browse position), sorted
+
+    std::string      m_query;              // last search, folded
+    std::vector<u32> m_result;
+    std::vector<s8>  m_memo;               // per location: -1 unknown, 0/1 match
+};
+
+// Lower-case ASCII with Latin-1 accents removed
+std::string foldSearchText(const char* s);
+
+extern SpawnerSearch g_search;
+
+void buildSpawnerSearch();   // over g_spawners; call after they are loaded
@@ -0,0 +1,285 @@
+#include "sigscan.h"
+#include "memsource.h"
+#include "spawners.h"
+#include "stash.h"
+#include "timing.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static constexpr size_t SCAN_CHUNK = 1 << 20;       // bytes per memory read
+static constexpr u32    SCAN_MAX_VALIDATE = 2048;   // candidates walked at most
+
+// ============================================================
+// Byte Signatures
+// ============================================================
+
+bool parseSignature(const char* text, Signature& out) {
+    out.bytes.clear();
+    out.mask.clear();
+    const char* p = text;
+    while (*p) {
+        if (*p == ' ' || *p == '\t') { p++; continue; }
+        if (*p == '?') {
+            out.bytes.push_back(0);
+            out.mask.push_back(0);
+            p += (p[1] == '?') ? 2 : 1;
+            continue;
+        }
+        char* end;
+        char hex[3] = {p[0], p[1], 0};
+        unsigned long v = strtoul(hex, &end, 16);
+        if (end != hex + 2) return false;
+        out.bytes.push_back((u8)v);
+        out.mask.push_back(0xFF);
+        p += 2;
+    }
+    return !out.bytes.empty();
+}
+
+static bool matchAt(const u8* p, const Signature& sig) {
+    for (size_t k = 0; k < sig.bytes.size(); k++)
+        if ((p[k] & sig.mask[k]) != sig.bytes[k]) return false;
+    return true;
+}
+
+// Vector search for the first exact byte of the signature, full masked
+// compare only where it occurs.
+void findSignature(const u8* data, size_t len, const Signature& sig, std::vector<size_t>& hits) {
+    const size_t n = sig.bytes.size();
+    if (n == 0 || len < n) return;
+
+    size_t anchor = 0;
+    while (anchor < n && sig.mask[anchor] != 0xFF) anchor++;
+    if (anchor == n) {                      // all wildcards
+        for (size_t i = 0; i + n <= len; i++) hits.push_back(i);
+        return;
+    }
+    const u8 a = sig.bytes[anchor];
+    const size_t last = len - n;            // last valid match offset
+    const u8* scan = data + anchor;
+    const size_t scanLen = last + 1;        // anchor positions to test
+
+    auto check = [&](size_t i) { if (matchAt(data + i, sig)) hits.push_back(i); };
+
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    const uint8x16_t needle = vdupq_n_u8(a);
+    for (; i + 16 <= scanLen; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(scan + i), needle);
+        // Narrow to 4 bits per byte so the mask fits a u64
+        u64 m = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        while (m) {
+            int bit = __builtin_ctzll(m) >> 2;
+            check(i + bit);
+            m &= ~(0xFull << (bit * 4));
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8((char)a);
+    for (; i + 16 <= scanLen; i += 16) {
+        u32 m = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(scan + i)), needle));
+        while (m) {
+            check(i + __builtin_ctz(m));
+            m &= m - 1;
+        }
+    }
+#endif
+    for (; i < scanLen; i++)
+        if (scan[i] == a) check(i);
+}
+
+// ============================================================
+// AArch64 Pointer Loads
+// ============================================================
+
+static constexpr u32 ADRP_MASK = 0x9F000000, ADRP_BITS = 0x90000000;
+
+bool decodeAdrpPair(u64 pc, u32 adrp, u32 next, u64* target) {
+    if ((adrp & ADRP_MASK) != ADRP_BITS) return false;
+    u32 rd = adrp & 0x1F;
+    if (((next >> 5) & 0x1F) != rd) return false;
+
+    u64 imm = (((u64)(adrp >> 5) & 0x7FFFF) << 2) | ((adrp >> 29) & 3);
+    s64 simm = (s64)(imm << 43) >> 43;      // sign-extend 21 bits
+    u64 page = (pc & ~0xFFFull) + ((u64)simm << 12);
+    u64 imm12 = (next >> 10) & 0xFFF;
+
+    if ((next & 0xFFC00000) == 0xF9400000) { *target = page + imm12 * 8; return true; }  // LDR Xt
+    if ((next & 0xFFC00000) == 0x91000000) { *target = page + imm12; return true; }      // ADD Xd
+    return false;
+}
+
+void scanPointerLoads(const u8* text, size_t len, u64 textAddr, u64 lo, u64 hi,
+                      std::vector<u64>& targets) {
+    const size_t count = len / 4;
+    if (count < 2) return;
+
+    auto pair = [&](size_t k) {
+        u32 w0, w1;
+        memcpy(&w0, text + k * 4, 4);
+        memcpy(&w1, text + k * 4 + 4, 4);
+        u64 t;
+        if (decodeAdrpPair(textAddr + k * 4, w0, w1, &t) && t >= lo && t < hi)
+            targets.push_back(t);
+    };
+
+    // Four instructions per vector; most blocks hold no ADRP at all
+    size_t k = 0;
+#if defined(__ARM_NEON)
+    const uint32x4_t mask = vdupq_n_u32(ADRP_MASK), bits = vdupq_n_u32(ADRP_BITS);
+    for (; k + 4 < count; k += 4) {
+        uint32x4_t eq = vceqq_u32(vandq_u32(vld1q_u32((const u32*)(text + k * 4)), mask), bits);
+        if (vmaxvq_u32(eq) == 0) continue;
+        for (int j = 0; j < 4; j++) pair(k + j);
+    }
+#elif defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi32((int)ADRP_MASK), bits = _mm_set1_epi32((int)ADRP_BITS);
+    for (; k + 4 < count; k += 4) {
+        __m128i w  = _mm_loadu_si128((const __m128i*)(text + k * 4));
+        __m128i eq = _mm_cmpeq_epi32(_mm_and_si128(w, mask), bits);
+        int m = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (m) {
+            pair(k + __builtin_ctz(m));
+            m &= m - 1;
+        }
+    }
+#endif
+    for (; k + 1 < count; k++) pair(k);
+}
+
+// ============================================================
+// Candidates
+// ============================================================
+
+static u64 distanceToKnown(u64 off) {
+    u64 best = ~0ull;
+    for (const auto& v : g_profile.versions) {
+        u64 bp = v.basePointer;
+        best = std::min(best, off > bp ? off - bp : bp - off);
+    }
+    return best;
+}
+
+void rankCandidates(std::vector<u64>& offsets) {
+    std::sort(offsets.begin(), offsets.end());
+    offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+    std::stable_sort(offsets.begin(), offsets.end(),
+                     [](u64 a, u64 b) { return distanceToKnown(a) < distanceToKnown(b); });
+}
+
+// Every slot must be a terminator/empty or a known spawner whose PA9
+// passes its checksum, with no entries after the first terminator.
+// Random memory essentially never passes ten of these in a row. A block
+// with no slot in use (a zeroed or not yet initialised stash) passes
+// nothing either way and counts as Unreachable.
+BaseCheck checkBasePointer(MemorySource& mem, const DmntCheatProcessMetadata& meta, u64 basePointer) {
+    GameVersion ver = {{}, "auto", basePointer};
+    u64 addr;
+    if (R_FAILED(resolveStashAddress(mem, meta, ver, &addr))) return BaseCheck::Unreachable;
+
+    u8 buf[STASH_MAX_SIZE];
+    if (R_FAILED(mem.read(addr, buf, g_profile.stashSize))) return BaseCheck::Unreachable;
+
+    int recognised = 0;
+    bool ended = false;
+    for (int i = 0; i < g_profile.slots; i++) {
+        StashSlot s;
+        decodeSlot(&buf[i * g_profile.entrySize], s);
+        if (s.hash == TERMINATOR_HASH) { ended = true; recognised++; continue; }
+        if (s.hash == 0) { ended = true; continue; }
+        if (ended || !s.checksumOk || !findSpawner(s.hash)) return BaseCheck::Invalid;
+        recognised++;
+    }
+    return recognised > 0 ? BaseCheck::Valid : BaseCheck::Unreachable;
+}
+
+// ============================================================
+// Detection
+// ============================================================
+
+bool detectBasePointer(MemorySource& mem, const DmntCheatProcessMetadata& meta,
+                       const ScanOptions& opt, ScanResult& out,
+                       const std::atomic<bool>* cancel) {
+    out = ScanResult();
+    u64 t0 = nowNs();
+
+    Signature sig;
+    bool useSig = !opt.signature.empty() && parseSignature(opt.signature.c_str(), sig);
+
+    // Map the NSO: R-X is .text, RW- is .data/.bss where the global lives.
+    // .rodata holds no code, so neither search needs it.
+    const u64 base = meta.main_nso_extents.base;
+    const u64 end  = base + meta.main_nso_extents.size;
+    struct Segment { u64 addr, size; };
+    std::vector<Segment> text;
+    u64 dataLo = ~0ull, dataHi = 0;
+    for (u64 addr = base; addr < end;) {
+        MemoryInfo mi;
+        if (R_FAILED(mem.queryMemory(addr, &mi)) || mi.size == 0) break;
+        u64 lo = std::max(mi.addr, addr), hi = std::min(mi.addr + mi.size, end);
+        if (mi.perm == Perm_Rx) text.push_back({lo, hi - lo});
+        if (mi.perm == Perm_Rw) { dataLo = std::min(dataLo, lo); dataHi = std::max(dataHi, hi); }
+        addr = mi.addr + mi.size;
+    }
+    if (text.empty() || dataLo >= dataHi) return false;
+
+    // Chunks overlap so a pair or signature straddling a boundary is seen;
+    // a multiple of 4 keeps instructions aligned
+    size_t overlap = useSig ? sig.bytes.size() : 8;
+    overlap = (overlap + 3) & ~(size_t)3;
+    std::vector<u8> buf(SCAN_CHUNK + overlap);
+    std::vector<u64> targets;
+    std::vector<size_t> hits;
+
+    for (const Segment& seg : text) {
+        for (u64 off = 0; off < seg.size; off += SCAN_CHUNK) {
+            if (cancel && *cancel) return false;
+            size_t len = (size_t)std::min<u64>(SCAN_CHUNK + overlap, seg.size - off);
+            if (R_FAILED(mem.read(seg.addr + off, buf.data(), len))) continue;
+            out.bytesScanned += len;
+            if (useSig) {
+                hits.clear();
+                findSignature(buf.data(), len, sig, hits);
+                for (size_t h : hits) {
+                    size_t at = h + opt.adrpOffset;
+                    if (at + 8 > len) continue;
+                    u32 w0, w1;
+                    memcpy(&w0, &buf[at], 4);
+                    memcpy(&w1, &buf[at + 4], 4);
+                    u64 t;
+                    if (decodeAdrpPair(seg.addr + off + at, w0, w1, &t) && t >= dataLo && t < dataHi)
+                        targets.push_back(t);
+                }
+            } else {
+                scanPointerLoads(buf.data(), len, seg.addr + off, dataLo, dataHi, targets);
+            }
+        }
+    }
+
+    for (u64& t : targets) t -= base;
+    rankCandidates(targets);
+    out.candidates = (u32)targets.size();
+
+    bool found = false;
+    for (u64 off : targets) {
+        if (out.validated >= SCAN_MAX_VALIDATE || (cancel && *cancel)) break;
+        out.validated++;
+        BaseCheck check = checkBasePointer(mem, meta, off);
+        if (check == BaseCheck::Unreachable) out.unreachable++;
+        if (check == BaseCheck::Valid) {
+            out.basePointer = off;
+            found = true;
+            break;
+        }
+    }
+    out.elapsedNs = nowNs() - t0;
+    return found;
+}
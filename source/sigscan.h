@@ -0,0 +1,72 @@
+#pragma once
+#include <switch.h>
+#include <switch/dmntcht.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+class MemorySource;
+
+// ============================================================
+// Signature Scan (base pointer auto-detection)
+// ============================================================
+//
+// Fallback for builds missing from the game profile. The main NSO's .text
+// and .rodata are read in large chunks and searched for the code that
+// loads the stash manager global: either a configured byte signature
+// ("F4 4F ?? A9 ..."), or every ADRP + LDR/ADD pair whose target lies
+// in the NSO's .data/.bss. Candidates are ranked by distance to the
+// known base pointers and each one is checked by walking the pointer chain
+// and sanity-checking the slot headers it leads to.
+
+struct Signature {
+    std::vector<u8> bytes;
+    std::vector<u8> mask;   // 0xFF = must match, 0x00 = wildcard
+};
+
+// Hex bytes separated by spaces, "?" or "??" for a wildcard.
+bool parseSignature(const char* text, Signature& out);
+
+// Appends the offset of every match of `sig` in `data`.
+void findSignature(const u8* data, size_t len, const Signature& sig, std::vector<size_t>& hits);
+
+// Decodes an AArch64 ADRP followed by LDR Xt,[Xn,#imm] or ADD Xd,Xn,#imm
+// on the same register. `pc` is the address of the ADRP.
+bool decodeAdrpPair(u64 pc, u32 adrp, u32 next, u64* target);
+
+// Appends the target of every ADRP pair in `text` (loaded at `textAddr`)
+// that lands in [lo, hi).
+void scanPointerLoads(const u8* text, size_t len, u64 textAddr, u64 lo, u64 hi,
+                      std::vector<u64>& targets);
+
+// Sorts/dedups candidate base pointers (NSO-relative), nearest to a
+// known profile version first.
+void rankCandidates(std::vector<u64>& offsets);
+
+// Where basePointer + the pointer chain leads. Unreachable (a null or unmapped
+// link, or an all-empty block) is normal before a save is loaded and proves
+// nothing; Invalid means the block was read and is not a stash.
+enum class BaseCheck { Valid, Unreachable, Invalid };
+BaseCheck checkBasePointer(MemorySource& mem, const DmntCheatProcessMetadata& meta, u64 basePointer);
+
+struct ScanOptions {
+    bool        enabled = true;
+    bool        cache = true;   // remember results per build (offsetcache.h)
+    std::string signature;      // empty: scan all ADRP pairs
+    int         adrpOffset = 0; // byte offset of the ADRP inside the signature
+};
+
+struct ScanResult {
+    u64 basePointer  = 0;       // NSO-relative, valid when found
+    u64 bytesScanned = 0;
+    u32 candidates   = 0;
+    u32 validated    = 0;       // candidates walked before the answer
+    u32 unreachable  = 0;       // walked candidates that proved nothing
+    u64 elapsedNs    = 0;
+};
+
+// Stops early (returning false) once `cancel` is set.
+bool detectBasePointer(MemorySource& mem, const DmntCheatProcessMetadata& meta,
+                       const ScanOptions& opt, ScanResult& out,
+                       const std::atomic<bool>* cancel = nullptr);
@@ -0,0 +1,114 @@
+#include "spatial.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr float GRID_PER_CELL = 4.0f;   // target points per cell
+static constexpr int   GRID_MAX_DIM  = 1024;
+
+SpatialGrid g_spatial[MAP_MAX];
+
+void SpatialGrid::clear() {
+    m_cols = m_rows = 0;
+    m_cellStart.clear();
+    m_points.clear();
+}
+
+void SpatialGrid::build(const std::vector<SpawnerEntry>& spawners, int mapIdx) {
+    clear();
+    std::vector<Point> pts;
+    for (int i = 0; i < (int)spawners.size(); i++)
+        if (spawners[i].mapIdx == mapIdx) pts.push_back({spawners[i].x, spawners[i].z, i});
+    if (pts.empty()) return;
+
+    float maxX = pts[0].x, maxZ = pts[0].z;
+    m_minX = maxX;
+    m_minZ = maxZ;
+    for (const auto& p : pts) {
+        m_minX = std::min(m_minX, p.x); maxX = std::max(maxX, p.x);
+        m_minZ = std::min(m_minZ, p.z); maxZ = std::max(maxZ, p.z);
+    }
+    float w = maxX - m_minX, h = maxZ - m_minZ;
+    float area = std::max(w, 1e-3f) * std::max(h, 1e-3f);
+    m_cell = std::sqrt(area * GRID_PER_CELL / pts.size());
+    m_cell = std::max({m_cell, w / GRID_MAX_DIM, h / GRID_MAX_DIM, 1e-3f});
+    m_invCell = 1.0f / m_cell;
+    m_cols = std::min(GRID_MAX_DIM, (int)(w * m_invCell) + 1);
+    m_rows = std::min(GRID_MAX_DIM, (int)(h * m_invCell) + 1);
+
+    // Counting sort by cell
+    m_cellStart.assign(m_cols * m_rows + 1, 0);
+    for (const auto& p : pts) m_cellStart[cellZ(p.z) * m_cols + cellX(p.x) + 1]++;
+    for (size_t c = 1; c < m_cellStart.size(); c++) m_cellStart[c] += m_cellStart[c - 1];
+    std::vector<u32> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    m_points.resize(pts.size());
+    for (const auto& p : pts) m_points[fill[cellZ(p.z) * m_cols + cellX(p.x)]++] = p;
+}
+
+int SpatialGrid::cellX(float x) const {
+    return std::clamp((int)((x - m_minX) * m_invCell), 0, m_cols - 1);
+}
+
+int SpatialGrid::cellZ(float z) const {
+    return std::clamp((int)((z - m_minZ) * m_invCell), 0, m_rows - 1);
+}
+
+int SpatialGrid::nearest(float x, float z, float* outDist) const {
+    if (m_points.empty()) return -1;
+    const float inf = std::numeric_limits<float>::infinity();
+    int cx = cellX(x), cz = cellZ(z);
+    float best = inf;
+    int bestIdx = -1;
+
+    auto visit = [&](int i, int j) {
+        int c = j * m_cols + i;
+        for (u32 k = m_cellStart[c]; k < m_cellStart[c + 1]; k++) {
+            const Point& p = m_points[k];
+            float dx = p.x - x, dz = p.z - z;
+            float d = dx * dx + dz * dz;
+            if (d < best) { best = d; bestIdx = p.idx; }
+        }
+    };
+
+    int maxRing = std::max(m_cols, m_rows);
+    for (int r = 0; r <= maxRing; r++) {
+        int i0 = cx - r, i1 = cx + r, j0 = cz - r, j1 = cz + r;
+        for (int j : {j0, j1}) {
+            if (j < 0 || j >= m_rows) continue;
+            for (int i = std::max(i0, 0); i <= std::min(i1, m_cols - 1); i++) visit(i, j);
+            if (r == 0) break;
+        }
+        for (int i : {i0, i1}) {
+            if (r == 0 || i < 0 || i >= m_cols) continue;
+            for (int j = std::max(j0 + 1, 0); j <= std::min(j1 - 1, m_rows - 1); j++) visit(i, j);
+        }
+        if (bestIdx < 0) continue;
+
+        // Anything not yet visited lies outside cells [i0, i1] x [j0, j1];
+        // sides already at the grid edge have nothing beyond them.
+        float gap = inf;
+        if (i0 > 0)          gap = std::min(gap, x - (m_minX + i0 * m_cell));
+        if (i1 < m_cols - 1) gap = std::min(gap, m_minX + (i1 + 1) * m_cell - x);
+        if (j0 > 0)          gap = std::min(gap, z - (m_minZ + j0 * m_cell));
+        if (j1 < m_rows - 1) gap = std::min(gap, m_minZ + (j1 + 1) * m_cell - z);
+        if (gap == inf || (gap > 0 && gap * gap >= best)) break;
+    }
+    if (outDist) *outDist = std::sqrt(best);
+    return bestIdx;
+}
+
+void SpatialGrid::radius(float x, float z, float r, std::vector<int>& out) const {
+    if (m_points.empty()) return;
+    float r2 = r * r;
+    int i0 = cellX(x - r), i1 = cellX(x + r);
+    int j0 = cellZ(z - r), j1 = cellZ(z + r);
+    for (int j = j0; j <= j1; j++) {
+        for (u32 k = m_cellStart[j * m_cols + i0]; k < m_cellStart[j * m_cols + i1 + 1]; k++) {
+            const Point& p = m_points[k];
+            float dx = p.x - x, dz = p.z - z;
+            if (dx * dx + dz * dz <= r2) out.push_back(p.idx);
+        }
+    }
+}
+
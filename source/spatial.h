@@ -0,0 +1,50 @@
+#pragma once
+#include <switch.h>
+
+#include <vector>
+
+#include "profile.h"
+#include "spawners.h"
+
+// ============================================================
+// Spatial Index
+// ============================================================
+//
+// Uniform grid over the world x/z of one map's spawners, sized for a
+// few points per cell. Points are stored cell by cell (offsets in
+// m_cellStart), so a query touches a handful of contiguous runs.
+// nearest() searches outward ring by ring and stops once no unvisited
+// cell can hold anything closer than the best hit.
+//
+// The grid keeps indices into the vector it was built from; rebuild
+// it whenever that vector changes.
+
+class SpatialGrid {
+public:
+    void build(const std::vector<SpawnerEntry>& spawners, int mapIdx);
+    void clear();
+
+    bool empty() const { return m_points.empty(); }
+    int  size() const  { return (int)m_points.size(); }
+
+    // Index of the closest spawner to (x, z), or -1 if the map has none.
+    // `outDist` gets the distance.
+    int nearest(float x, float z, float* outDist = nullptr) const;
+
+    // Appends the index of every spawner within `r` of (x, z).
+    void radius(float x, float z, float r, std::vector<int>& out) const;
+
+private:
+    struct Point { float x, z; int idx; };
+
+    int cellX(float x) const;
+    int cellZ(float z) const;
+
+    float m_minX = 0, m_minZ = 0;
+    float m_cell = 1, m_invCell = 1;
+    int   m_cols = 0, m_rows = 0;
+    std::vector<u32>   m_cellStart;   // m_cols * m_rows + 1
+    std::vector<Point> m_points;
+};
+
+extern SpatialGrid g_spatial[MAP_MAX];
@@ -0,0 +1,111 @@
+#include "spawners.h"
+#include "namehash.h"
+
+#include <charconv>
+#include <unordered_set>
+
+// ============================================================
+// Spawner Data
+// ============================================================
+
+std::vector<SpawnerEntry> g_spawners;
+
+// Location names repeat for every spawner of an area, so consecutive
+// lines almost always hit the one-entry cache before the set.
+struct LocationHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+static std::unordered_set<std::string, LocationHash, std::equal_to<>> g_locations;
+
+static const char* internLocation(std::string_view name) {
+    static const std::string* last = nullptr;
+    if (last && *last == name) return last->c_str();
+    auto it = g_locations.find(name);
+    if (it == g_locations.end()) it = g_locations.emplace(name).first;
+    last = &*it;
+    return last->c_str();
+}
+
+static bool parseHex64(std::string_view s, u64& out) {
+    if (s.size() != 16) return false;
+    u64 v = 0;
+    for (char c : s) {
+        u32 d;
+        if (c >= '0' && c <= '9')      d = c - '0';
+        else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+        else return false;
+        v = (v << 4) | d;
+    }
+    out = v;
+    return true;
+}
+
+static const char* skipSpace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+// "x, y, z" with optional blanks around the commas, like "%f, %f, %f".
+static bool parseVec3(const char* p, const char* end, float& x, float& y, float& z) {
+    float* out[3] = {&x, &y, &z};
+    for (int i = 0; i < 3; i++) {
+        if (i > 0) {
+            p = skipSpace(p, end);
+            if (p == end || *p != ',') return false;
+            p++;
+        }
+        p = skipSpace(p, end);
+        if (p < end && *p == '+') p++;
+        auto r = std::from_chars(p, end, *out[i]);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+    }
+    return true;
+}
+
+void parseSpawnerFile(std::string_view content, int mapIdx, NameTemplates* names) {
+    static constexpr std::string_view SEP = " - ";
+    while (!content.empty()) {
+        size_t le = content.find('\n');
+        std::string_view line = content.substr(0, le);
+        content.remove_prefix(le == std::string_view::npos ? content.size() : le + 1);
+        if (line.size() < 20) continue;
+
+        size_t d1 = line.find(SEP);
+        if (d1 == std::string_view::npos) continue;
+        size_t hs = d1 + SEP.size();
+        size_t d2 = line.find(SEP, hs);
+        if (d2 == std::string_view::npos) continue;
+
+        u64 hash;
+        if (!parseHex64(line.substr(hs, d2 - hs), hash)) continue;
+
+        size_t v = line.find("V3f(");
+        if (v == std::string_view::npos) continue;
+        size_t cs = v + 4, ce = line.find(')', cs);
+        if (ce == std::string_view::npos) continue;
+
+        float x, y, z;
+        if (!parseVec3(line.data() + cs, line.data() + ce, x, y, z)) continue;
+
+        std::string_view loc = line.substr(0, d1);
+        size_t ns = loc.find_first_not_of(" \t\"");
+        size_t ne = loc.find_last_not_of(" \t\"");
+        loc = ns != std::string_view::npos ? loc.substr(ns, ne - ns + 1) : std::string_view();
+
+        g_spawners.push_back({hash, x, y, z, mapIdx, internLocation(loc)});
+        if (names) {
+            std::string_view name = line.substr(d2 + SEP.size(), v - d2 - SEP.size());
+            size_t at = name.find(" @");
+            names->add(name.substr(0, at));
+        }
+    }
+}
+
+const SpawnerEntry* findSpawner(u64 hash) {
+    for (const auto& sp : g_spawners)
+        if (sp.hash == hash) return &sp;
+    return nullptr;
+}
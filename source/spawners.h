@@ -0,0 +1,56 @@
+#pragma once
+#include <switch.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================
+// Map Transform (from ShinyStashMap/MapTransform.cs)
+// ============================================================
+
+struct MapTransform {
+    double texW, texH;
+    double rangeX, rangeZ;
+    double scaleX, scaleZ;
+    double dirX, dirZ;
+    double offsetX, offsetZ;
+
+    double convertX(double x) const {
+        return (texW / 2.0) + (dirX * ((rangeX / scaleX) * (x + offsetX)));
+    }
+    double convertZ(double z) const {
+        return (texH / 2.0) + (dirZ * ((rangeZ / scaleZ) * (z + offsetZ)));
+    }
+
+    // Texture pixel back to world coordinates
+    double invertX(double tx) const {
+        return (tx - texW / 2.0) / (dirX * (rangeX / scaleX)) - offsetX;
+    }
+    double invertZ(double tz) const {
+        return (tz - texH / 2.0) / (dirZ * (rangeZ / scaleZ)) - offsetZ;
+    }
+};
+
+// ============================================================
+// Spawner Data
+// ============================================================
+
+struct SpawnerEntry {
+    u64 hash;
+    float x, y, z;
+    int mapIdx;             // index into g_profile.maps
+    const char* location;   // interned, lives for the whole run
+};
+
+extern std::vector<SpawnerEntry> g_spawners;
+
+class NameTemplates;
+
+// Appends every valid line of a spawner file to g_spawners:
+//   "<location> - <16 hex hash> - <name> @ V3f(<x>, <y>, <z>)",
+// Works on the buffer in place; the only allocations are g_spawners
+// growth and the first sighting of each location name. With `names`,
+// each line's name is also added to those templates (namehash.h).
+void parseSpawnerFile(std::string_view content, int mapIdx, NameTemplates* names = nullptr);
+const SpawnerEntry* findSpawner(u64 hash);
@@ -0,0 +1,161 @@
+#include "species.h"
+#include "paths.h"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+static constexpr char SPECIES_EN[] =
+#include "species_en.inc"
+    ;
+
+static constexpr int SPECIES_COUNT = [] {
+    int n = 1;
+    for (char c : SPECIES_EN) n += c == '\n';
+    return n;
+}();
+
+struct EmbeddedTable {
+    std::array<char, sizeof(SPECIES_EN)> blob;   // names, each NUL-terminated
+    std::array<u32, SPECIES_COUNT>       offset;
+};
+
+static constexpr EmbeddedTable g_embeddedEn = [] {
+    EmbeddedTable t{};
+    int n = 0;
+    t.offset[n++] = 0;
+    for (size_t i = 0; i < sizeof(SPECIES_EN); i++) {
+        t.blob[i] = SPECIES_EN[i] == '\n' ? '\0' : SPECIES_EN[i];
+        if (SPECIES_EN[i] == '\n') t.offset[n++] = (u32)(i + 1);
+    }
+    return t;
+}();
+
+// ============================================================
+// Language Packs
+// ============================================================
+
+struct SpeciesPack {
+    const char* blob;
+    const u32*  offset;
+    int         count;
+    bool        loaded;      // tried to load (count 0: not available)
+    std::unique_ptr<char[]> blobData;
+    std::unique_ptr<u32[]>  offsetData;
+};
+
+static SpeciesPack g_packs[SPECIES_LANG_COUNT] = {
+    {g_embeddedEn.blob.data(), g_embeddedEn.offset.data(), SPECIES_COUNT, true, nullptr, nullptr},
+};
+static const SpeciesPack* g_active = &g_packs[0];
+static int g_activeLang = 0;
+
+// Whole file in one read, then newlines become terminators in place.
+static bool loadPackFile(const char* path, SpeciesPack& pack) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) { fclose(f); return false; }
+
+    std::unique_ptr<char[]> blob(new char[size + 1]);
+    bool ok = fread(blob.get(), 1, size, f) == (size_t)size;
+    fclose(f);
+    if (!ok) return false;
+    blob[size] = '\0';
+
+    int lines = 1;
+    for (long i = 0; i < size; i++) lines += blob[i] == '\n';
+    std::unique_ptr<u32[]> offset(new u32[lines]);
+    int n = 0;
+    offset[n++] = 0;
+    for (long i = 0; i < size; i++) {
+        if (blob[i] == '\r') blob[i] = '\0';
+        if (blob[i] != '\n') continue;
+        blob[i] = '\0';
+        offset[n++] = (u32)(i + 1);
+    }
+    if (n > 1 && offset[n - 1] == (u32)size) n--;   // trailing newline
+
+    pack.blob = blob.get();
+    pack.offset = offset.get();
+    pack.count = n;
+    pack.blobData = std::move(blob);
+    pack.offsetData = std::move(offset);
+    return true;
+}
+
+static void packPath(char* path, size_t size, const char* root, int lang) {
+    snprintf(path, size, "%sspecies_%s.txt", root, SPECIES_LANGS[lang]);
+}
+
+static const SpeciesPack* getPack(int lang) {
+    SpeciesPack& pack = g_packs[lang];
+    if (!pack.loaded) {
+        pack.loaded = true;
+        char path[256];
+        packPath(path, sizeof(path), DATA_ROOT, lang);
+        if (!loadPackFile(path, pack)) {
+            packPath(path, sizeof(path), ROMFS_ROOT, lang);
+            loadPackFile(path, pack);
+        }
+    }
+    return pack.count > 0 ? &pack : nullptr;
+}
+
+// ============================================================
+// Lookup
+// ============================================================
+
+const char* speciesName(u16 ndex) {
+    if (ndex < g_active->count) {
+        const char* name = g_active->blob + g_active->offset[ndex];
+        if (*name) return name;
+    }
+    return ndex < SPECIES_COUNT ? &g_embeddedEn.blob[g_embeddedEn.offset[ndex]] : nullptr;
+}
+
+int speciesCount() { return SPECIES_COUNT; }
+
+bool setSpeciesLanguage(const char* code) {
+    for (int i = 0; i < SPECIES_LANG_COUNT; i++) {
+        if (strcmp(code, SPECIES_LANGS[i]) != 0) continue;
+        const SpeciesPack* pack = getPack(i);
+        if (!pack) return false;
+        g_active = pack;
+        g_activeLang = i;
+        return true;
+    }
+    return false;
+}
+
+const char* speciesLanguage() { return SPECIES_LANGS[g_activeLang]; }
+
+bool cycleSpeciesLanguage() {
+    for (int step = 1; step < SPECIES_LANG_COUNT; step++) {
+        int lang = (g_activeLang + step) % SPECIES_LANG_COUNT;
+        const SpeciesPack* pack = getPack(lang);
+        if (!pack) continue;
+        g_active = pack;
+        g_activeLang = lang;
+        return true;
+    }
+    return false;
+}
+
+bool speciesPacksInstalled() {
+    static const bool installed = [] {
+        for (int lang = 1; lang < SPECIES_LANG_COUNT; lang++) {
+            if (g_packs[lang].count > 0) return true;
+            for (const char* root : {DATA_ROOT, ROMFS_ROOT}) {
+                char path[256];
+                packPath(path, sizeof(path), root, lang);
+                if (FILE* f = fopen(path, "rb")) { fclose(f); return true; }
+            }
+        }
+        return false;
+    }();
+    return installed;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <switch.h>
+
+// ============================================================
+// Species Names
+// ============================================================
+//
+// A language pack is one NUL-separated UTF-8 blob plus a u32 offset
+// per national dex number. English is packed at compile time from
+// species_en.inc. Other languages are read on first use from
+// species_<code>.txt (one name per line, dex order) in DATA_ROOT or
+// ROMFS_ROOT with a single read, and kept; switching language after
+// that only swaps the active pack. Names missing from a pack fall
+// back to English.
+
+// Language codes in cycling order, as used by PKHeX.
+static constexpr const char* SPECIES_LANGS[] = {"en", "ja", "fr", "it", "de", "es", "ko", "zh-Hans", "zh-Hant"};
+static constexpr int SPECIES_LANG_COUNT = sizeof(SPECIES_LANGS) / sizeof(SPECIES_LANGS[0]);
+
+// Name for a national dex number in the active language, or nullptr
+// if out of range.
+const char* speciesName(u16 ndex);
+int         speciesCount();
+
+// Activates a language, loading its pack if needed. False (and the
+// active language unchanged) if no pack is available.
+bool        setSpeciesLanguage(const char* code);
+const char* speciesLanguage();
+
+// Activates the next language after the current one that has a pack;
+// returns false if English is the only one.
+bool        cycleSpeciesLanguage();
+
+// Whether any non-English pack file exists, checked once without loading
+// it. The app ships none, so language switching is offered only then.
+bool        speciesPacksInstalled();
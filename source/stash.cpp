@@ -0,0 +1,93 @@
+#include "stash.h"
+#include "memsource.h"
+#include "pkx.h"
+#include "spawners.h"
+
+#include <cstdio>
+#include <cstring>
+
+// ============================================================
+// Shiny Stash
+// ============================================================
+
+Result resolveStashAddress(MemorySource& mem, const DmntCheatProcessMetadata& meta,
+                           const GameVersion& ver, u64* outAddr) {
+    u64 addr = meta.main_nso_extents.base + ver.basePointer;
+    u64 ptr;
+    for (int i = 0; i < g_profile.chainLen; i++) {
+        Result rc = mem.read(addr, &ptr, sizeof(u64));
+        if (R_FAILED(rc)) return rc;
+        addr = ptr + g_profile.chain[i];
+    }
+    *outAddr = addr;
+    return 0;
+}
+
+void buildStashCheat(const GameVersion& ver, DmntCheatDefinition* out) {
+    memset(out, 0, sizeof(*out));
+    snprintf(out->readable_name, sizeof(out->readable_name), "Shiny Stash Live Map (v%s)", ver.version);
+
+    u32* op = out->opcodes;
+    int n = 0;
+    // Type 5: 5TMRI0AA AAAAAAAA, T=8 bytes, M=main NSO or I=register-relative
+    op[n++] = 0x58000000 | (u32)((ver.basePointer >> 32) & 0xFF);
+    op[n++] = (u32)ver.basePointer;
+    const int last = g_profile.chainLen - 1;
+    for (int i = 0; i < last; i++) {
+        op[n++] = 0x58001000 | (u32)((g_profile.chain[i] >> 32) & 0xFF);
+        op[n++] = (u32)g_profile.chain[i];
+    }
+    // Type 7: 7T0RC000 VVVVVVVV, C=0 add
+    op[n++] = 0x78000000;
+    op[n++] = (u32)g_profile.chain[last];
+    // Type C3: C3000XXS, XX >= 0x80 saves register S
+    op[n++] = 0xC3000000 | ((u32)STASH_STATIC_REG << 4);
+    out->num_opcodes = n;
+}
+
+void decodeSlot(const u8* entry, StashSlot& out) {
+    memcpy(&out.hash, entry, sizeof(u64));
+    out.speciesInternal = 0;
+    out.nationalDex = 0;
+    out.checksumOk = true;
+    if (out.hash == 0 || out.hash == TERMINATOR_HASH) return;
+
+    // Decrypt PA9 data to read species
+    u8 pa9[PA9_SIZE];
+    memcpy(pa9, entry + g_profile.pa9Offset, PA9_SIZE);
+    decryptPA9(pa9, PA9_SIZE);
+    out.checksumOk = pa9ChecksumValid(pa9);
+    if (!out.checksumOk) return;   // garbage species; keep the entry flagged
+
+    memcpy(&out.speciesInternal, &pa9[PA9_SPECIES_OFF], sizeof(u16));
+    if (out.speciesInternal) out.nationalDex = getNational9(out.speciesInternal);
+}
+
+void buildEntries(const StashSlot* slots, int count, std::vector<ShinyEntry>& out) {
+    out.clear();
+    for (int i = 0; i < count; i++) {
+        const StashSlot& s = slots[i];
+        if (s.hash == 0 || s.hash == TERMINATOR_HASH) break;
+        if (s.checksumOk && s.speciesInternal == 0) continue; // skip empty entries
+        // Outside the spawner files is kept (the app names it by hash lookup),
+        // unless the PA9 is garbage too
+        if (!s.checksumOk && !findSpawner(s.hash)) continue;
+
+        bool dup = false;
+        for (auto& e : out)
+            if (e.hash == s.hash) { dup = true; break; }
+        if (!dup)
+            out.push_back({s.hash, s.speciesInternal, s.nationalDex, s.checksumOk});
+    }
+}
+
+void decodeStash(const u8* buf, std::vector<ShinyEntry>& out) {
+    StashSlot slots[STASH_MAX_SLOTS];
+    const int n = g_profile.slots, es = g_profile.entrySize;
+    int count = 0;
+    for (; count < n; count++) {
+        decodeSlot(&buf[count * es], slots[count]);
+        if (slots[count].hash == 0 || slots[count].hash == TERMINATOR_HASH) { count++; break; }
+    }
+    buildEntries(slots, count, out);
+}
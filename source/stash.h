@@ -0,0 +1,63 @@
+#pragma once
+#include <switch.h>
+#include <switch/dmntcht.h>
+
+#include <vector>
+
+#include "profile.h"
+
+class MemorySource;
+
+// ============================================================
+// Game Constants
+// ============================================================
+//
+// Per-patch values (title ID, versions, pointer chain, stash layout)
+// live in the game profile, see profile.h.
+
+static constexpr u64 TERMINATOR_HASH   = 0xCBF29CE484222645ULL;
+static constexpr int PA9_SPECIES_OFF   = 0x08;  // species u16 within PA9
+
+// ============================================================
+// Shiny Stash
+// ============================================================
+
+struct ShinyEntry {
+    u64 hash;
+    u16 speciesInternal;
+    u16 nationalDex;
+    bool checksumOk;        // false: PA9 failed its checksum, species unknown
+};
+
+// Walks basePointer + the profile's pointer chain to the stash block address.
+Result resolveStashAddress(MemorySource& mem, const DmntCheatProcessMetadata& meta,
+                           const GameVersion& ver, u64* outAddr);
+
+// Static register the cheat below publishes the stash address in.
+// 0x80-0xFF are writable by cheats and readable over IPC.
+static constexpr u8 STASH_STATIC_REG = 0xF0;
+
+// Fills `out` with a dmnt cheat-VM program doing the same walk every
+// frame inside the game and saving the result to STASH_STATIC_REG:
+//   58000000+ : R0 = [main + basePointer]
+//   58001000+ : R0 = [R0 + chain[i]]            (all but the last)
+//   78000000  : R0 += chain[last]
+//   C3000F00  : static[0xF0] = R0
+void buildStashCheat(const GameVersion& ver, DmntCheatDefinition* out);
+
+// One decoded entrySize slot of the raw block.
+struct StashSlot {
+    u64 hash;
+    u16 speciesInternal;    // 0 for an empty slot
+    u16 nationalDex;
+    bool checksumOk;
+};
+
+void decodeSlot(const u8* entry, StashSlot& out);
+
+// Builds the entry list from decoded slots: stops at the terminator,
+// skips empty slots, unknown spawners and duplicates.
+void buildEntries(const StashSlot* slots, int count, std::vector<ShinyEntry>& out);
+
+// Decodes a raw stashSize block into entries with a known spawner.
+void decodeStash(const u8* buf, std::vector<ShinyEntry>& out);
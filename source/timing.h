@@ -0,0 +1,11 @@
+#pragma once
+#include <switch.h>
+
+#include <chrono>
+
+// Monotonic time in nanoseconds (steady_clock is backed by the
+// system tick on console and CLOCK_MONOTONIC on the host).
+inline u64 nowNs() {
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
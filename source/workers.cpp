@@ -0,0 +1,32 @@
+#include "workers.h"
+
+#include <bit>
+
+// Cores 0-2 run applications on HOS; core 3 is the system's even when
+// the process mask allows it
+#ifdef __SWITCH__
+static constexpr u64 APP_CORE_MASK = 0x7;
+#else
+static constexpr u64 APP_CORE_MASK = ~0ULL;
+#endif
+
+static u64 coreMask() {
+    static const u64 mask = []() -> u64 {
+        u64 m = 0;
+        if (R_FAILED(svcGetInfo(&m, InfoType_CoreMask, CUR_PROCESS_HANDLE, 0)) || m == 0) return 1;
+        return (m & APP_CORE_MASK) ? m & APP_CORE_MASK : m;
+    }();
+    return mask;
+}
+
+int workerCores() {
+    return std::popcount(coreMask());
+}
+
+void pinToCore(int n) {
+    u64 mask = coreMask();
+    n %= std::popcount(mask);
+    int core = 0;
+    while (!((mask >> core) & 1) || n-- > 0) core++;
+    svcSetThreadCoreMask(CUR_THREAD_HANDLE, core, 1u << core);
+}
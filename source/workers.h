@@ -0,0 +1,16 @@
+#pragma once
+#include <switch.h>
+
+// ============================================================
+// Worker Threads
+// ============================================================
+//
+// std::thread under libnx starts every thread on the default core with
+// no affinity, so a pool of them takes turns on one core. CPU-bound
+// pools size themselves with workerCores() and each thread pins itself
+// with pinToCore(). On the console that is the cores the process may
+// run on (0-2 for an application, from its kernel core mask); on the
+// host it is every hardware thread and pinning is left to the OS.
+
+int  workerCores();      // at least 1
+void pinToCore(int n);   // calling thread to the n-th usable core (n wraps)